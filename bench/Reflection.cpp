@@ -0,0 +1,380 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ * @brief   Measures the cost of properties and reflection.
+ *
+ * Covers construction and destruction of objects against their number of properties, property
+ * access through direct, custom and concurrent accessors compared to plain member access, the
+ * string conversions of every numeric property type, enum properties and the memory footprint
+ * of reflectable objects per property. All timings are printed in nanoseconds per operation.
+ */
+
+#include "zycore/Property.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace zycore;
+
+// ============================================================================================== //
+// Harness                                                                                        //
+// ============================================================================================== //
+
+static std::atomic<std::size_t> g_sink(0);
+static std::atomic<bool> g_countAllocations(false);
+static std::atomic<std::size_t> g_allocatedBytes(0);
+
+void* operator new(std::size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed))
+    {
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (auto memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * @brief   Times a callable.
+ * @param   func    The callable to time.
+ * @return  The elapsed time in nanoseconds.
+ */
+template<typename FuncT>
+double timeNs(FuncT func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+/**
+ * @brief   Determines the number of operations to run so each measurement takes a similar time.
+ * @param   costPerOp   The rough amount of work per operation.
+ * @return  The number of operations.
+ */
+static std::size_t numOps(std::size_t costPerOp)
+{
+    const std::size_t kBudget = 4000000;
+    return std::max<std::size_t>(kBudget / std::max<std::size_t>(costPerOp, 1), 100);
+}
+
+/**
+ * @brief   Keeps the compiler from caching values across loop iterations.
+ */
+static inline void barrier()
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+// ============================================================================================== //
+// Test objects                                                                                   //
+// ============================================================================================== //
+
+namespace zycore
+{
+    ZYCORE_DECLARE_ENUM_PROPERTY(BenchColor, 
+        Black, White, Red, Green, Blue, Cyan, Magenta, Yellow, Orange, Purple, Brown, Grey);
+} // namespace zycore
+
+#define ZYCORE_BENCH_PROPERTY(index)                                                               \
+    int value##index = 0;                                                                          \
+    Property<int> property##index{this, "property" #index, value##index};
+
+#define ZYCORE_BENCH_PROPERTIES8(prefix)                                                           \
+    ZYCORE_BENCH_PROPERTY(prefix##0) ZYCORE_BENCH_PROPERTY(prefix##1)                              \
+    ZYCORE_BENCH_PROPERTY(prefix##2) ZYCORE_BENCH_PROPERTY(prefix##3)                              \
+    ZYCORE_BENCH_PROPERTY(prefix##4) ZYCORE_BENCH_PROPERTY(prefix##5)                              \
+    ZYCORE_BENCH_PROPERTY(prefix##6) ZYCORE_BENCH_PROPERTY(prefix##7)
+
+struct NoProperties : ReflectableObject
+{
+    int value = 0;
+};
+
+struct OneProperty : ReflectableObject
+{
+    ZYCORE_BENCH_PROPERTY(0)
+};
+
+struct EightProperties : ReflectableObject
+{
+    ZYCORE_BENCH_PROPERTIES8(0)
+};
+
+struct SixtyFourProperties : ReflectableObject
+{
+    ZYCORE_BENCH_PROPERTIES8(0) ZYCORE_BENCH_PROPERTIES8(1) ZYCORE_BENCH_PROPERTIES8(2)
+    ZYCORE_BENCH_PROPERTIES8(3) ZYCORE_BENCH_PROPERTIES8(4) ZYCORE_BENCH_PROPERTIES8(5)
+    ZYCORE_BENCH_PROPERTIES8(6) ZYCORE_BENCH_PROPERTIES8(7)
+};
+
+struct OneEnumProperty : ReflectableObject
+{
+    BenchColor color = Black;
+    Property<BenchColor> colorProperty{this, "color", color};
+};
+
+struct AccessorVariants : ReflectableObject
+{
+    int plain = 0;
+    int direct = 0;
+    Property<int> directProperty{this, "direct", direct};
+    int custom = 0;
+    Property<int> customProperty{this, "custom", custom, 
+        [this]() -> const int& { return custom; }, [this](const int& v) { custom = v; }};
+    int concurrent = 0;
+    ConcurrentProperty<int> concurrentProperty{this, "concurrent", concurrent};
+};
+
+template<typename T>
+struct Holder : ReflectableObject
+{
+    T value = T();
+    Property<T> property{this, "value", value};
+};
+
+// ============================================================================================== //
+// Scenarios                                                                                      //
+// ============================================================================================== //
+
+/**
+ * @brief   Construction and destruction cost of an object class.
+ * @param   name            The name of the class.
+ * @param   numProperties   The number of properties the class declares.
+ */
+template<typename T>
+static void runLifetime(const char* name, std::size_t numProperties)
+{
+    // The first instance registers the properties with the meta class.
+    delete new T;
+
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    auto n = numOps(numProperties * 16) / 4;
+    std::vector<Storage> storage(n);
+    auto constructNs = timeNs([&] 
+    { 
+        for (auto& cur : storage) new (&cur) T; 
+    }) / n;
+    auto destructNs = timeNs([&] 
+    { 
+        for (auto& cur : storage) reinterpret_cast<T*>(&cur)->~T(); 
+    }) / n;
+    auto perProperty = static_cast<double>(std::max<std::size_t>(numProperties, 1));
+    std::printf("%-30s %8zu %12.1f %12.1f %12.2f\n", name, numProperties, constructNs, destructNs,
+        (constructNs + destructNs) / perProperty);
+}
+
+/**
+ * @brief   Construction and destruction cost against the number of properties.
+ */
+static void benchLifetime()
+{
+    std::printf("\n%-30s %8s %12s %12s %12s\n", "construct+destroy", "props", "ns/ctor", 
+        "ns/dtor", "ns/prop");
+    runLifetime<NoProperties>("no properties", 0);
+    runLifetime<OneProperty>("int properties", 1);
+    runLifetime<EightProperties>("int properties", 8);
+    runLifetime<SixtyFourProperties>("int properties", 64);
+    runLifetime<OneEnumProperty>("enum property", 1);
+}
+
+/**
+ * @brief   Reading and writing through the different kinds of accessors.
+ */
+static void benchAccess()
+{
+    std::printf("\n%-30s %8s %12s %12s\n", "access", "", "ns/get", "ns/set");
+    AccessorVariants object;
+    auto n = numOps(1) * 4;
+    std::size_t sum = 0;
+
+    auto run = [&](const char* name, auto get, auto set)
+    {
+        auto getNs = timeNs([&] 
+        { 
+            for (std::size_t i = 0; i < n; ++i) { sum += get(); barrier(); } 
+        }) / n;
+        auto setNs = timeNs([&] 
+        { 
+            for (std::size_t i = 0; i < n; ++i) { set(static_cast<int>(i)); barrier(); } 
+        }) / n;
+        std::printf("%-30s %8s %12.2f %12.2f\n", name, "", getNs, setNs);
+    };
+
+    run("plain member", 
+        [&] { return object.plain; }, 
+        [&](int v) { object.plain = v; });
+    run("default accessors", 
+        [&] { return object.directProperty.get(); }, 
+        [&](int v) { object.directProperty.set(v); });
+    run("custom accessors", 
+        [&] { return object.customProperty.get(); }, 
+        [&](int v) { object.customProperty.set(v); });
+    run("ConcurrentProperty", 
+        [&] { return object.concurrentProperty.get(); }, 
+        [&](int v) { object.concurrentProperty.set(v); });
+    g_sink.fetch_add(sum, std::memory_order_relaxed);
+}
+
+/**
+ * @brief   String conversion cost of a property type.
+ * @param   name    The name of the type.
+ * @param   sample  The value converted.
+ */
+template<typename T>
+static void runConversion(const char* name, T sample)
+{
+    Holder<T> object;
+    object.property.set(sample);
+    auto n = numOps(64);
+    std::size_t sum = 0;
+
+    auto toStringNs = timeNs([&] 
+    { 
+        for (std::size_t i = 0; i < n; ++i) sum += object.property.toString().size(); 
+    }) / n;
+
+    auto text = object.property.toString();
+    auto fromStringNs = timeNs([&] 
+    { 
+        for (std::size_t i = 0; i < n; ++i) object.property.fromString(text); 
+    }) / n;
+
+    char buffer[64];
+    auto toCharsNs = timeNs([&] 
+    { 
+        for (std::size_t i = 0; i < n; ++i) 
+        {
+            sum += object.property.toChars(buffer, buffer + sizeof(buffer)) - buffer; 
+        }
+    }) / n;
+
+    auto end = object.property.toChars(buffer, buffer + sizeof(buffer));
+    auto tryFromCharsNs = timeNs([&] 
+    { 
+        for (std::size_t i = 0; i < n; ++i) sum += object.property.tryFromChars(buffer, end); 
+    }) / n;
+
+    g_sink.fetch_add(sum, std::memory_order_relaxed);
+    std::printf("%-30s %12.1f %12.1f %12.1f %12.1f\n", name, toStringNs, fromStringNs, toCharsNs,
+        tryFromCharsNs);
+}
+
+/**
+ * @brief   String conversion cost of all numeric and enum property types.
+ */
+static void benchConversion()
+{
+    std::printf("\n%-30s %12s %12s %12s %12s\n", "conversion", "toString", "fromString", 
+        "toChars", "tryFromChars");
+    runConversion<unsigned char>("unsigned char", 200);
+    runConversion<short>("short", -12345);
+    runConversion<unsigned short>("unsigned short", 54321);
+    runConversion<int>("int", -123456789);
+    runConversion<unsigned int>("unsigned int", 3123456789u);
+    runConversion<long>("long", -1234567890l);
+    runConversion<unsigned long>("unsigned long", 3123456789ul);
+    runConversion<long long>("long long", -1234567890123456789ll);
+    runConversion<unsigned long long>("unsigned long long", 12345678901234567890ull);
+    runConversion<float>("float", 3.14159274f);
+    runConversion<double>("double", 2.718281828459045);
+    runConversion<long double>("long double", 1.4142135623730950488l);
+    runConversion<BenchColor>("enum (12 enumerators)", Magenta);
+}
+
+/**
+ * @brief   Memory footprint of a class.
+ * @param   name            The name of the class.
+ * @param   numProperties   The number of properties the class declares.
+ * @param   memberBytes     The size of the reflected members.
+ */
+template<typename T>
+static void runFootprint(const char* name, std::size_t numProperties, std::size_t memberBytes)
+{
+    // The first instance allocates the shared meta class data, which is not part of the object.
+    delete new T;
+
+    g_allocatedBytes.store(0, std::memory_order_relaxed);
+    g_countAllocations.store(true, std::memory_order_relaxed);
+    std::unique_ptr<T> object(new T);
+    g_countAllocations.store(false, std::memory_order_relaxed);
+    auto heapBytes = g_allocatedBytes.load(std::memory_order_relaxed) - sizeof(T);
+
+    auto overhead = sizeof(T) + heapBytes - sizeof(NoProperties) - memberBytes 
+        + sizeof(NoProperties::value);
+    auto perProperty = static_cast<double>(std::max<std::size_t>(numProperties, 1));
+    std::printf("%-30s %8zu %12zu %12zu %12.1f\n", name, numProperties, sizeof(T), heapBytes, 
+        static_cast<double>(overhead) / perProperty);
+}
+
+/**
+ * @brief   Memory footprint of reflectable objects per property.
+ */
+static void benchFootprint()
+{
+    std::printf("\n%-30s %8s %12s %12s %12s\n", "footprint", "props", "sizeof", "heap bytes", 
+        "bytes/prop");
+    runFootprint<NoProperties>("no properties", 0, sizeof(int));
+    runFootprint<OneProperty>("int properties", 1, sizeof(int));
+    runFootprint<EightProperties>("int properties", 8, 8 * sizeof(int));
+    runFootprint<SixtyFourProperties>("int properties", 64, 64 * sizeof(int));
+    runFootprint<OneEnumProperty>("enum property", 1, sizeof(BenchColor));
+    runFootprint<AccessorVariants>("default+custom+concurrent", 3, 4 * sizeof(int));
+}
+
+// ============================================================================================== //
+// Entry point                                                                                    //
+// ============================================================================================== //
+
+int main()
+{
+    benchLifetime();
+    benchAccess();
+    benchConversion();
+    benchFootprint();
+    return g_sink.load() ? 0 : 1;
+}
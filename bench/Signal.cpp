@@ -0,0 +1,326 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ * @brief   Measures signal emission, connection and teardown costs.
+ *          
+ * Covers emission throughput against the number of slots, the cost of connecting member 
+ * functions compared to lambdas, disconnecting by handle, destroying signal objects with many
+ * connections, emission from many threads on the same signal and connect/disconnect churn from
+ * many threads on a plain and a sharded signal. All timings are printed in nanoseconds per 
+ * operation.
+ */
+
+#include "zycore/ShardedSignal.hpp"
+#include "zycore/SignalObject.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace zycore;
+
+// ============================================================================================== //
+// Harness                                                                                        //
+// ============================================================================================== //
+
+static std::atomic<std::size_t> g_sink(0);
+
+struct Receiver : SignalObject
+{
+    std::size_t sum = 0;
+    void onValue(int value) { sum += value; }
+};
+
+/**
+ * @brief   Times a callable.
+ * @param   func    The callable to time.
+ * @return  The elapsed time in nanoseconds.
+ */
+template<typename FuncT>
+double timeNs(FuncT func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+/**
+ * @brief   Determines the number of operations to run so each measurement takes a similar time.
+ * @param   costPerOp   The rough amount of work per operation.
+ * @return  The number of operations.
+ */
+static std::size_t numOps(std::size_t costPerOp)
+{
+    const std::size_t kBudget = 4000000;
+    return std::max<std::size_t>(kBudget / std::max<std::size_t>(costPerOp, 1), 100);
+}
+
+// ============================================================================================== //
+// Scenarios                                                                                      //
+// ============================================================================================== //
+
+/**
+ * @brief   Emission throughput against the number of connected slots.
+ */
+static void benchEmit()
+{
+    std::printf("\n%-30s %8s %12s %12s\n", "emit", "slots", "ns/emit", "ns/slot");
+    for (std::size_t numSlots : {1, 10, 100, 1000})
+    {
+        Signal<int> sig;
+        std::vector<std::unique_ptr<Receiver>> receivers;
+        for (std::size_t i = 0; i < numSlots; ++i)
+        {
+            receivers.emplace_back(new Receiver);
+            sig.connect(receivers.back().get(), &Receiver::onValue);
+        }
+
+        auto n = numOps(numSlots);
+        auto ns = timeNs([&] { for (std::size_t i = 0; i < n; ++i) sig.emit(1); }) / n;
+        std::printf("%-30s %8zu %12.1f %12.2f\n", "member slots", numSlots, ns, ns / numSlots);
+
+        Signal<int> lambdaSig;
+        for (std::size_t i = 0; i < numSlots; ++i)
+        {
+            lambdaSig.connect([](int v) { g_sink.fetch_add(v, std::memory_order_relaxed); });
+        }
+        ns = timeNs([&] { for (std::size_t i = 0; i < n; ++i) lambdaSig.emit(1); }) / n;
+        std::printf("%-30s %8zu %12.1f %12.2f\n", "lambda slots", numSlots, ns, ns / numSlots);
+    }
+}
+
+/**
+ * @brief   Connection and disconnection cost of member function and lambda slots.
+ */
+static void benchConnect()
+{
+    const std::size_t kNumConnections = 10000;
+    std::printf("\n%-30s %8s %12s %12s\n", "connect", "conns", "ns/connect", "ns/disconn");
+
+    std::vector<std::unique_ptr<Receiver>> receivers;
+    for (std::size_t i = 0; i < kNumConnections; ++i)
+    {
+        receivers.emplace_back(new Receiver);
+    }
+    std::vector<SlotHandle> handles(kNumConnections);
+
+    {
+        Signal<int> sig;
+        auto connectNs = timeNs([&]
+        {
+            for (std::size_t i = 0; i < kNumConnections; ++i)
+            {
+                handles[i] = sig.connect(receivers[i].get(), &Receiver::onValue);
+            }
+        }) / kNumConnections;
+        auto disconnectNs = timeNs([&] 
+        { 
+            for (auto handle : handles) sig.disconnect(handle); 
+        }) / kNumConnections;
+        std::printf("%-30s %8zu %12.1f %12.1f\n", "connect(obj, &T::member)", kNumConnections,
+            connectNs, disconnectNs);
+    }
+
+    {
+        Signal<int> sig;
+        auto connectNs = timeNs([&]
+        {
+            for (std::size_t i = 0; i < kNumConnections; ++i)
+            {
+                handles[i] = sig.connect(
+                    [](int v) { g_sink.fetch_add(v, std::memory_order_relaxed); });
+            }
+        }) / kNumConnections;
+        auto disconnectNs = timeNs([&] 
+        { 
+            for (auto handle : handles) sig.disconnect(handle); 
+        }) / kNumConnections;
+        std::printf("%-30s %8zu %12.1f %12.1f\n", "connect(lambda)", kNumConnections, connectNs, 
+            disconnectNs);
+    }
+}
+
+/**
+ * @brief   Teardown cost of signal objects and signals with many connections.
+ */
+static void benchTeardown()
+{
+    std::printf("\n%-30s %8s %12s %12s\n", "teardown", "conns", "ns total", "ns/conn");
+    for (std::size_t numConnections : {100, 1000, 10000})
+    {
+        // One object connected to many signals.
+        {
+            std::vector<std::unique_ptr<Signal<int>>> signals;
+            std::unique_ptr<Receiver> receiver(new Receiver);
+            for (std::size_t i = 0; i < numConnections; ++i)
+            {
+                signals.emplace_back(new Signal<int>);
+                signals.back()->connect(receiver.get(), &Receiver::onValue);
+            }
+            auto ns = timeNs([&] { receiver.reset(); });
+            std::printf("%-30s %8zu %12.0f %12.1f\n", "~SignalObject", numConnections, ns, 
+                ns / numConnections);
+        }
+
+        // Many objects connected to one signal, destroyed in connection order.
+        {
+            Signal<int> sig;
+            std::vector<std::unique_ptr<Receiver>> receivers;
+            for (std::size_t i = 0; i < numConnections; ++i)
+            {
+                receivers.emplace_back(new Receiver);
+                sig.connect(receivers.back().get(), &Receiver::onValue);
+            }
+            auto ns = timeNs([&] { receivers.clear(); });
+            std::printf("%-30s %8zu %12.0f %12.1f\n", "~SignalObject, shared signal", 
+                numConnections, ns, ns / numConnections);
+        }
+
+        // Signal going away first.
+        {
+            std::unique_ptr<Signal<int>> sig(new Signal<int>);
+            std::vector<std::unique_ptr<Receiver>> receivers;
+            for (std::size_t i = 0; i < numConnections; ++i)
+            {
+                receivers.emplace_back(new Receiver);
+                sig->connect(receivers.back().get(), &Receiver::onValue);
+            }
+            auto ns = timeNs([&] { sig.reset(); });
+            std::printf("%-30s %8zu %12.0f %12.1f\n", "~Signal", numConnections, ns, 
+                ns / numConnections);
+        }
+    }
+}
+
+/**
+ * @brief   Emission scaling with multiple threads emitting on the same signal.
+ */
+static void benchContention()
+{
+    const std::size_t kNumSlots = 8;
+    const std::size_t kEmitsPerThread = 20000;
+    std::printf("\n%-30s %8s %12s %12s\n", "contended emit", "threads", "ns/emit", "Memit/s");
+
+    Signal<int> sig;
+    for (std::size_t i = 0; i < kNumSlots; ++i)
+    {
+        sig.connect([](int v) { g_sink.fetch_add(v, std::memory_order_relaxed); });
+    }
+
+    for (std::size_t numThreads : {1, 2, 4, 8, 16, 32, 64})
+    {
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (std::size_t j = 0; j < kEmitsPerThread; ++j) sig.emit(1);
+            });
+        }
+
+        auto totalEmits = numThreads * kEmitsPerThread;
+        auto ns = timeNs([&]
+        {
+            go.store(true, std::memory_order_release);
+            for (auto& curThread : threads) curThread.join();
+        });
+        std::printf("%-30s %8zu %12.1f %12.2f\n", "8 lambda slots", numThreads, 
+            ns / totalEmits, totalEmits / ns * 1000.);
+    }
+}
+
+/**
+ * @brief   Connect/disconnect churn from multiple threads on one signal.
+ * @param   name        The name of the scenario.
+ * @param   sig         The signal.
+ * @param   numThreads  The number of churning threads.
+ */
+template<typename SignalT>
+static void runChurn(const char* name, SignalT& sig, std::size_t numThreads)
+{
+    const std::size_t kChurnsPerThread = 20000;
+
+    std::atomic<bool> go(false);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&]
+        {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (std::size_t j = 0; j < kChurnsPerThread; ++j)
+            {
+                sig.disconnect(sig.connect(
+                    [](int v) { g_sink.fetch_add(v, std::memory_order_relaxed); }));
+            }
+        });
+    }
+
+    auto totalChurns = numThreads * kChurnsPerThread;
+    auto ns = timeNs([&]
+    {
+        go.store(true, std::memory_order_release);
+        for (auto& curThread : threads) curThread.join();
+    });
+    std::printf("%-30s %8zu %12.1f %12.2f\n", name, numThreads, ns / totalChurns, 
+        totalChurns / ns * 1000.);
+}
+
+/**
+ * @brief   Connect/disconnect churn on a plain compared to a sharded signal.
+ */
+static void benchChurn()
+{
+    std::printf("\n%-30s %8s %12s %12s\n", "connect+disconnect churn", "threads", "ns/churn", 
+        "Mchurn/s");
+    for (std::size_t numThreads : {1, 4, 16, 64})
+    {
+        Signal<int> sig;
+        runChurn("Signal", sig, numThreads);
+        ShardedSignal<int> shardedSig;
+        runChurn("ShardedSignal", shardedSig, numThreads);
+    }
+}
+
+// ============================================================================================== //
+// Entry point                                                                                    //
+// ============================================================================================== //
+
+int main()
+{
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    benchEmit();
+    benchConnect();
+    benchTeardown();
+    benchContention();
+    benchChurn();
+    return g_sink.load() ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ * @brief   Measures the cost of awaiting signal emissions from coroutines.
+ *          
+ * Covers a coroutine awaiting a signal in a loop, resumed from inside @c emit and through an 
+ * event loop, and the cost a signal keeps paying for having been awaited once, with and without
+ * regular slots. Requires C++20 coroutines. All timings are printed in nanoseconds per 
+ * operation.
+ */
+
+#include "zycore/SignalAwaitable.hpp"
+
+#ifndef __cpp_impl_coroutine
+#error "this benchmark requires C++20 coroutines"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+
+using namespace zycore;
+
+// ============================================================================================== //
+// Harness                                                                                        //
+// ============================================================================================== //
+
+static std::atomic<std::size_t> g_sink(0);
+
+/**
+ * @brief   Coroutine running eagerly and destroying itself when it finishes.
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+ * @brief   Times a callable.
+ * @param   func    The callable to time.
+ * @return  The elapsed time in nanoseconds.
+ */
+template<typename FuncT>
+double timeNs(FuncT func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+/**
+ * @brief   Awaits a number of emissions, resumed on the emitting thread.
+ */
+static DetachedTask awaitEmissions(Signal<int>& sig, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto result = co_await sig.next();
+        g_sink.fetch_add(std::get<0>(result.value()), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief   Awaits a number of emissions, resumed through an event loop.
+ */
+static DetachedTask awaitEmissions(Signal<int>& sig, EventLoop& loop, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto result = co_await sig.next(loop);
+        g_sink.fetch_add(std::get<0>(result.value()), std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================================== //
+// Scenarios                                                                                      //
+// ============================================================================================== //
+
+/**
+ * @brief   Round trip of awaiting and resuming a coroutine per emission.
+ */
+static void benchAwait()
+{
+    const std::size_t kNumEmissions = 1000000;
+    std::printf("\n%-30s %12s\n", "await", "ns/emit");
+
+    {
+        Signal<int> sig;
+        awaitEmissions(sig, kNumEmissions);
+        auto ns = timeNs([&] { for (std::size_t i = 0; i < kNumEmissions; ++i) sig.emit(1); });
+        std::printf("%-30s %12.1f\n", "next()", ns / kNumEmissions);
+    }
+
+    {
+        Signal<int> sig;
+        EventLoop loop;
+        awaitEmissions(sig, loop, kNumEmissions);
+        auto ns = timeNs([&]
+        {
+            for (std::size_t i = 0; i < kNumEmissions; ++i)
+            {
+                sig.emit(1);
+                loop.processEvents();
+            }
+        });
+        std::printf("%-30s %12.1f\n", "next(loop)", ns / kNumEmissions);
+    }
+}
+
+/**
+ * @brief   Emission cost of a signal that was awaited before, but has no waiters left.
+ */
+static void benchIdleHub()
+{
+    const std::size_t kNumEmissions = 1000000;
+    std::printf("\n%-30s %8s %12s %12s %8s\n", "idle hub", "slots", "ns/emit", "ns/async", 
+        "numSlots");
+
+    for (std::size_t numSlots : {0, 1})
+    {
+        for (bool awaited : {false, true})
+        {
+            Signal<int> sig;
+            for (std::size_t i = 0; i < numSlots; ++i)
+            {
+                sig.connect([](int v) { g_sink.fetch_add(v, std::memory_order_relaxed); });
+            }
+            if (awaited)
+            {
+                awaitEmissions(sig, 1);
+                sig.emit(1);
+            }
+
+            auto ns = timeNs([&] 
+            { 
+                for (std::size_t i = 0; i < kNumEmissions; ++i) sig.emit(1); 
+            }) / kNumEmissions;
+            auto asyncNs = timeNs([&] 
+            { 
+                for (std::size_t i = 0; i < kNumEmissions / 100; ++i) sig.emitAsync(1).wait(); 
+            }) / (kNumEmissions / 100);
+            std::printf("%-30s %8zu %12.1f %12.1f %8zu\n", 
+                awaited ? "awaited once" : "never awaited", numSlots, ns, asyncNs, sig.numSlots());
+        }
+    }
+}
+
+// ============================================================================================== //
+// Entry point                                                                                    //
+// ============================================================================================== //
+
+int main()
+{
+    benchAwait();
+    benchIdleHub();
+    return g_sink.load() ? 0 : 1;
+}
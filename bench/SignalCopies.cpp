@@ -0,0 +1,161 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ * @brief   Counts the argument copies made by the different signal emission paths.
+ *          
+ * The payload type counts its copy and move constructions. The process exits with a non-zero
+ * status if emitting to slots taking constant references copies the payload.
+ */
+
+#include "zycore/SignalObject.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace zycore;
+
+// ============================================================================================== //
+// [Payload]                                                                                      //
+// ============================================================================================== //
+
+/**
+ * @brief   Message-bus style payload counting how often it is copied and moved.
+ */
+struct Payload
+{
+    static std::size_t copies;
+    static std::size_t moves;
+
+    std::vector<uint8_t> data;
+
+    Payload() : data(4096, 0x42) {}
+    Payload(const Payload& other) : data(other.data) { ++copies; }
+    Payload(Payload&& other) : data(std::move(other.data)) { ++moves; }
+    Payload& operator = (const Payload& other) { data = other.data; ++copies; return *this; }
+    Payload& operator = (Payload&& other) { data = std::move(other.data); ++moves; return *this; }
+
+    static void resetCounters() { copies = moves = 0; }
+};
+
+std::size_t Payload::copies = 0;
+std::size_t Payload::moves = 0;
+
+struct Receiver : SignalObject
+{
+    std::size_t sum = 0;
+    void onPayload(const Payload& payload) { sum += payload.data.size(); }
+};
+
+// ============================================================================================== //
+// Harness                                                                                        //
+// ============================================================================================== //
+
+static const std::size_t kNumEmits = 2000;
+static std::size_t g_sink = 0;
+
+/**
+ * @brief   Runs a scenario and prints copies, moves and time per emission.
+ * @return  The number of copies per emission.
+ */
+template<typename SetupT, typename EmitT>
+double runScenario(const char* name, std::size_t numSlots, SetupT setup, EmitT emit)
+{
+    Signal<Payload> sig;
+    std::vector<std::unique_ptr<Receiver>> receivers;
+    for (std::size_t i = 0; i < numSlots; ++i)
+    {
+        setup(sig, receivers);
+    }
+
+    Payload::resetCounters();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kNumEmits; ++i)
+    {
+        emit(sig);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto copies = static_cast<double>(Payload::copies) / kNumEmits;
+    auto moves = static_cast<double>(Payload::moves) / kNumEmits;
+    auto ns = std::chrono::duration<double, std::nano>(elapsed).count() / kNumEmits;
+    std::printf("%-34s %6zu %10.2f %10.2f %12.0f\n", name, numSlots, copies, moves, ns);
+    return copies;
+}
+
+// ============================================================================================== //
+// Entry point                                                                                    //
+// ============================================================================================== //
+
+int main()
+{
+    const Payload payload;
+    bool ok = true;
+
+    std::printf("%-34s %6s %10s %10s %12s\n", "scenario", "slots", "copies/op", "moves/op", 
+        "ns/op");
+    for (std::size_t numSlots : {1, 8, 64})
+    {
+        ok &= runScenario("emit, const& lambda", numSlots, 
+            [](Signal<Payload>& sig, std::vector<std::unique_ptr<Receiver>>&)
+            {
+                sig.connect([](const Payload& p) { g_sink += p.data.size(); });
+            }, 
+            [&](Signal<Payload>& sig) { sig.emit(payload); }) == 0.;
+
+        ok &= runScenario("emit, const& member", numSlots, 
+            [](Signal<Payload>& sig, std::vector<std::unique_ptr<Receiver>>& receivers)
+            {
+                receivers.emplace_back(new Receiver);
+                sig.connect(receivers.back().get(), &Receiver::onPayload);
+            }, 
+            [&](Signal<Payload>& sig) { sig.emit(payload); }) == 0.;
+
+        runScenario("emit, by-value lambda", numSlots, 
+            [](Signal<Payload>& sig, std::vector<std::unique_ptr<Receiver>>&)
+            {
+                sig.connect([](Payload p) { g_sink += p.data.size(); });
+            }, 
+            [&](Signal<Payload>& sig) { sig.emit(payload); });
+
+        runScenario("emitMove, by-value lambda", numSlots, 
+            [](Signal<Payload>& sig, std::vector<std::unique_ptr<Receiver>>&)
+            {
+                sig.connect([](Payload p) { g_sink += p.data.size(); });
+            }, 
+            [&](Signal<Payload>& sig) { sig.emitMove(Payload()); });
+
+        runScenario("emit, legacy FuncConnection", numSlots, 
+            [](Signal<Payload>& sig, std::vector<std::unique_ptr<Receiver>>&)
+            {
+                sig.connect(new FuncConnection<Payload>(
+                    [](const Payload& p) { g_sink += p.data.size(); }));
+            }, 
+            [&](Signal<Payload>& sig) { sig.emit(payload); });
+    }
+
+    std::printf("%s\n", ok ? "const& slots: zero copies" : "const& slots: UNEXPECTED COPIES");
+    return ok ? 0 : 1;
+}
@@ -67,6 +67,12 @@ public:
      * @brief   Destructor.
      */
     virtual ~BaseBinaryStream() {}
+
+    /**
+     * @brief   Gets the size of the managed buffer.
+     * @return  The buffer size.
+     */
+    StreamSize size() const;
 };
 
 // ============================================================================================== //
@@ -362,6 +368,11 @@ inline BaseBinaryStream::BaseBinaryStream(Buffer* buffer)
     assert(buffer);
 }
 
+inline auto BaseBinaryStream::size() const -> StreamSize
+{
+    return m_buffer->size();
+}
+
 // ============================================================================================== //
 // Implementation of inline and template functions [IBinaryStream]                                //
 // ============================================================================================== //
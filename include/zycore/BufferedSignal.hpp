@@ -0,0 +1,410 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_BUFFEREDSIGNAL_HPP
+#define ZYCORE_BUFFEREDSIGNAL_HPP
+
+#include "zycore/Signal.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+namespace zycore
+{
+
+/**
+ * @brief   Determines how a @c BufferedSignal treats repeated emissions.
+ */
+enum class BufferMode
+{
+    /**
+     * @brief   Only the last emission (per key, see @c BufferedSignal::setKeyFunction) is kept.
+     */
+    kCoalesce,
+    /**
+     * @brief   All emissions are kept in order.
+     */
+    kCollect,
+};
+
+// ============================================================================================== //
+// [BufferedSignal]                                                                               //
+// ============================================================================================== //
+
+/**
+ * @brief   Signal that buffers emissions inside batches and delivers them when the batch ends.
+ * @tparam  ArgsT The slot's argument types.
+ *
+ * Emissions are buffered while a batch is open (see @c ScopedBatch) or, if a flush loop is set, 
+ * until the loop runs its next batch of events. Otherwise they are delivered immediately.
+ *
+ * On flush, the buffered argument tuples are emitted one by one to the regular slots, and
+ * handed to the batch slots (see @c connectBatch) as a whole. In @c BufferMode::kCoalesce mode,
+ * an emission replaces the buffered one with the same key instead of being appended.
+ * 
+ * The signal derives privately from @c Signal, so it can't be used through a @c Signal 
+ * reference or pointer, which would emit past the buffer. Only the connection management is 
+ * exported, @c emitMove, @c emitAsync, @c emitTo and @c next are not available.
+ */
+template<typename... ArgsT>
+class BufferedSignal 
+    : private Signal<ArgsT...>
+{
+    using Base = Signal<ArgsT...>;
+public:
+    using ArgsTuple = std::tuple<std::decay_t<ArgsT>...>;
+    using Batch = std::vector<ArgsTuple>;
+    using KeyFunction = std::function<std::size_t(internal::SlotArg<ArgsT>...)>;
+private:
+    BufferMode m_mode;
+    KeyFunction m_keyFunc;
+    EventLoop* m_flushLoop;
+    mutable std::mutex m_bufferMutex;
+    Batch m_buffer;
+    std::unordered_map<std::size_t, std::size_t> m_keyIndices;
+    std::size_t m_batchDepth;
+    bool m_flushScheduled;
+    std::shared_ptr<BufferedSignal*> m_self;
+    Signal<const Batch&> m_batchSignal;
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   mode    The buffer mode.
+     */
+    explicit BufferedSignal(BufferMode mode = BufferMode::kCoalesce);
+
+    /**
+     * @brief   Destructor. Buffered emissions are discarded.
+     * @remarks If a flush loop is set, the signal must be destroyed on the loop's thread.
+     */
+    ~BufferedSignal() override;
+public: // Configuration.
+    /**
+     * @brief   Gets the buffer mode.
+     * @return  The buffer mode.
+     */
+    BufferMode mode() const;
+
+    /**
+     * @brief   Sets the function deriving the coalescing key from the emitted arguments.
+     * @param   keyFunc The key function. @c nullptr coalesces all emissions into one.
+     */
+    void setKeyFunction(KeyFunction keyFunc);
+
+    /**
+     * @brief   Buffers emissions until the given loop processes its next batch of events.
+     * @param   loop    The event loop to flush from. @c nullptr disables per-tick flushing.
+     */
+    void setFlushLoop(EventLoop* loop);
+public: // Connection management, see @c Signal.
+    using Base::connect;
+    using Base::disconnect;
+    using Base::numSlots;
+    using Base::makeScoped;
+#ifdef ZYCORE_SIGNAL_STATS
+    using Base::stats;
+#endif
+public: // Public interface.
+    /**
+     * @brief   Connects a slot receiving all buffered emissions at once.
+     * @param   func    The function/lambda to connect.
+     * @return  A handle to disconnect the slot using @c disconnectBatch.
+     */
+    template<typename FuncT>
+    SlotHandle connectBatch(FuncT&& func);
+
+    /**
+     * @brief   Connects a batch slot binding the connection lifetime to a signal object.
+     * @param   lifetimeGiver   The object to bind the connection to.
+     * @param   func            The function/lambda to connect.
+     * @return  A handle to disconnect the slot using @c disconnectBatch.
+     */
+    template<typename FuncT>
+    SlotHandle connectBatch(SignalObject* lifetimeGiver, FuncT&& func);
+
+    /**
+     * @brief   Disconnects a batch slot.
+     * @param   handle  The handle returned by @c connectBatch.
+     * @return  @c true on success, @c false if the connection didn't exist.
+     */
+    bool disconnectBatch(SlotHandle handle);
+
+    /**
+     * @brief   Emits the signal, buffering the arguments if a batch is open.
+     * @param   args    Arguments to be passed to the slots.
+     * @remarks This routine is thread-safe.
+     */
+    void emit(internal::SlotArg<ArgsT>... args);
+
+    /**
+     * @brief   Shorthand for @c emit.
+     */
+    void operator () (internal::SlotArg<ArgsT>... args);
+
+    /**
+     * @brief   Shorthand for @c connect.
+     * @param   func  The function (slot) to connect with the signal.
+     * @return  This instance.
+     */
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    BufferedSignal& operator += (FuncT&& func);
+
+    /**
+     * @brief   Opens a batch. Batches may be nested.
+     * @remarks This routine is thread-safe.
+     */
+    void beginBatch();
+
+    /**
+     * @brief   Closes a batch, flushing the buffer if it was the outermost one.
+     * @remarks This routine is thread-safe.
+     */
+    void endBatch();
+
+    /**
+     * @brief   Delivers all buffered emissions.
+     * @remarks This routine is thread-safe. The slots are called without holding the buffer 
+     *          lock, so they may emit the signal again.
+     */
+    void flush();
+public:
+    /**
+     * @brief   Keeps a batch open for the lifetime of the instance.
+     */
+    class ScopedBatch : public NonCopyable
+    {
+        BufferedSignal& m_signal;
+    public:
+        explicit ScopedBatch(BufferedSignal& signal) : m_signal(signal) { m_signal.beginBatch(); }
+        ~ScopedBatch() { m_signal.endBatch(); }
+    };
+private:
+    /**
+     * @brief   Appends or coalesces an emission into the buffer.
+     * @remarks The buffer lock has to be held.
+     */
+    void buffer(internal::SlotArg<ArgsT>... args);
+
+    /**
+     * @brief   Delivers a batch to all slots.
+     * @param   batch   The batch.
+     */
+    void deliver(const Batch& batch);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [BufferedSignal]                                              //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline BufferedSignal<ArgsT...>::BufferedSignal(BufferMode mode)
+    : m_mode(mode)
+    , m_flushLoop(nullptr)
+    , m_batchDepth(0)
+    , m_flushScheduled(false)
+    , m_self(std::make_shared<BufferedSignal*>(this))
+{}
+
+template<typename... ArgsT>
+inline BufferedSignal<ArgsT...>::~BufferedSignal()
+{
+    // Pending per-tick flushes only hold a weak reference.
+    m_self.reset();
+}
+
+template<typename... ArgsT>
+inline BufferMode BufferedSignal<ArgsT...>::mode() const
+{
+    return m_mode;
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::setKeyFunction(KeyFunction keyFunc)
+{
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    m_keyFunc = std::move(keyFunc);
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::setFlushLoop(EventLoop* loop)
+{
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    m_flushLoop = loop;
+}
+
+template<typename... ArgsT>
+template<typename FuncT>
+inline SlotHandle BufferedSignal<ArgsT...>::connectBatch(FuncT&& func)
+{
+    return m_batchSignal.connect(std::forward<FuncT>(func));
+}
+
+template<typename... ArgsT>
+template<typename FuncT>
+inline SlotHandle BufferedSignal<ArgsT...>::connectBatch(SignalObject* lifetimeGiver, 
+    FuncT&& func)
+{
+    return m_batchSignal.connect(lifetimeGiver, std::forward<FuncT>(func), 
+        ConnectionType::kDirect);
+}
+
+template<typename... ArgsT>
+inline bool BufferedSignal<ArgsT...>::disconnectBatch(SlotHandle handle)
+{
+    return m_batchSignal.disconnect(handle);
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::buffer(internal::SlotArg<ArgsT>... args)
+{
+    if (m_mode == BufferMode::kCollect)
+    {
+        m_buffer.emplace_back(args...);
+        return;
+    }
+
+    auto key = m_keyFunc ? m_keyFunc(args...) : 0;
+    auto it = m_keyIndices.find(key);
+    if (it == m_keyIndices.end())
+    {
+        m_keyIndices.emplace(key, m_buffer.size());
+        m_buffer.emplace_back(args...);
+    }
+    else
+    {
+        m_buffer[it->second] = ArgsTuple(args...);
+    }
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::emit(internal::SlotArg<ArgsT>... args)
+{
+    EventLoop* scheduleOn = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        if (m_batchDepth || m_flushLoop)
+        {
+            buffer(args...);
+            if (!m_batchDepth && !m_flushScheduled)
+            {
+                m_flushScheduled = true;
+                scheduleOn = m_flushLoop;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    if (scheduleOn)
+    {
+        std::weak_ptr<BufferedSignal*> weakSelf = m_self;
+        scheduleOn->post([weakSelf]
+        {
+            if (auto self = weakSelf.lock())
+            {
+                (*self)->flush();
+            }
+        });
+        return;
+    }
+
+    // Not buffering, deliver right away.
+    Base::emit(args...);
+    if (m_batchSignal.numSlots())
+    {
+        m_batchSignal.emit(Batch{ArgsTuple(args...)});
+    }
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::operator () (internal::SlotArg<ArgsT>... args)
+{
+    emit(args...);
+}
+
+template<typename... ArgsT>
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline BufferedSignal<ArgsT...>& BufferedSignal<ArgsT...>::operator += (FuncT&& func)
+{
+    connect(std::forward<FuncT>(func));
+    return *this;
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::beginBatch()
+{
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    ++m_batchDepth;
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::endBatch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        assert(m_batchDepth);
+        if (--m_batchDepth)
+        {
+            return;
+        }
+    }
+    flush();
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::flush()
+{
+    Batch batch;
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        batch.swap(m_buffer);
+        m_keyIndices.clear();
+        m_flushScheduled = false;
+    }
+
+    if (!batch.empty())
+    {
+        deliver(batch);
+    }
+}
+
+template<typename... ArgsT>
+inline void BufferedSignal<ArgsT...>::deliver(const Batch& batch)
+{
+    for (const auto& curArgs : batch)
+    {
+        internal::applyTuple([this](const auto&... args) { Base::emit(args...); }, curArgs, 
+            std::index_sequence_for<ArgsT...>());
+    }
+    m_batchSignal.emit(batch);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_BUFFEREDSIGNAL_HPP
@@ -0,0 +1,809 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_CHARCONV_HPP
+#define ZYCORE_CHARCONV_HPP
+
+#include "zycore/Config.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// Internal helpers                                                                               //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Floating point number with a 64 bit significand ("do it yourself floating point"),
+     *          as used by the Grisu algorithm.
+     */
+    struct DiyFp
+    {
+        uint64_t f;
+        int e;
+    };
+
+    inline DiyFp diyFpMultiply(DiyFp a, DiyFp b)
+    {
+        const uint64_t kMask32 = 0xFFFFFFFF;
+        uint64_t ah = a.f >> 32, al = a.f & kMask32;
+        uint64_t bh = b.f >> 32, bl = b.f & kMask32;
+        uint64_t hh = ah * bh, hl = ah * bl, lh = al * bh, ll = al * bl;
+        // Rounds the lower half into the result.
+        uint64_t mid = (ll >> 32) + (hl & kMask32) + (lh & kMask32) + (uint64_t(1) << 31);
+        return DiyFp{hh + (hl >> 32) + (lh >> 32) + (mid >> 32), a.e + b.e + 64};
+    }
+
+    inline DiyFp diyFpNormalize(DiyFp v)
+    {
+#ifdef ZYCORE_GNUC
+        auto shift = __builtin_clzll(v.f);
+        return DiyFp{v.f << shift, v.e - shift};
+#else
+        while (!(v.f & (uint64_t(1) << 63)))
+        {
+            v.f <<= 1;
+            --v.e;
+        }
+        return v;
+#endif
+    }
+
+    template<typename FloatT> 
+    struct FloatTraits;
+
+    template<>
+    struct FloatTraits<float>
+    {
+        using Bits = uint32_t;
+        static const int kSignificandBits = 23;
+        static const int kExponentBias = 127 + kSignificandBits;
+        static const unsigned kExponentMask = 0xFF;
+        // Largest significand and power of ten that are exact, for the parsing fast path.
+        static const uint64_t kMaxExactSignificand = uint64_t(1) << 24;
+        static const int kMaxExactPower = 10;
+    };
+
+    template<>
+    struct FloatTraits<double>
+    {
+        using Bits = uint64_t;
+        static const int kSignificandBits = 52;
+        static const int kExponentBias = 1023 + kSignificandBits;
+        static const unsigned kExponentMask = 0x7FF;
+        static const uint64_t kMaxExactSignificand = uint64_t(1) << 53;
+        static const int kMaxExactPower = 22;
+    };
+
+    template<>
+    struct FloatTraits<long double>
+    {
+        // Formatting uses the C library, parsing shares the limits of double.
+        static const uint64_t kMaxExactSignificand = uint64_t(1) << 53;
+        static const int kMaxExactPower = 22;
+    };
+
+    /**
+     * @brief   Decomposes a positive, finite value and computes the boundaries of the interval
+     *          of numbers rounding to it, all normalized to the exponent of the upper one.
+     */
+    template<typename FloatT>
+    inline void grisuBoundaries(FloatT value, DiyFp& v, DiyFp& minus, DiyFp& plus)
+    {
+        using Traits = FloatTraits<FloatT>;
+        typename Traits::Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const uint64_t hiddenBit = uint64_t(1) << Traits::kSignificandBits;
+        uint64_t significand = bits & (hiddenBit - 1);
+        auto biasedExponent = static_cast<int>(
+            (bits >> Traits::kSignificandBits) & Traits::kExponentMask);
+        if (biasedExponent)
+        {
+            v = DiyFp{significand | hiddenBit, biasedExponent - Traits::kExponentBias};
+        }
+        else
+        {
+            v = DiyFp{significand, 1 - Traits::kExponentBias};
+        }
+
+        plus = diyFpNormalize(DiyFp{(v.f << 1) + 1, v.e - 1});
+        // At powers of two, the gap to the next lower value is half as wide.
+        if (v.f == hiddenBit && biasedExponent > 1)
+        {
+            minus = DiyFp{(v.f << 2) - 1, v.e - 2};
+        }
+        else
+        {
+            minus = DiyFp{(v.f << 1) - 1, v.e - 1};
+        }
+        minus.f <<= minus.e - plus.e;
+        minus.e = plus.e;
+        v = diyFpNormalize(v);
+    }
+
+    /**
+     * @brief   Gets a cached power of ten @c c with @c -59 <= @c c.e + @c e + @c 64 <= @c -32.
+     * @param   e   The binary exponent to scale.
+     * @param   k   Receives the negated decimal exponent of the power.
+     */
+    inline DiyFp grisuCachedPower(int e, int& k)
+    {
+        // 10^-348, 10^-340, ..., 10^340
+        static const DiyFp kPowers[] = 
+        {
+                {0xFA8FD5A0081C0288, -1220}, {0xBAAEE17FA23EBF76, -1193},
+                {0x8B16FB203055AC76, -1166}, {0xCF42894A5DCE35EA, -1140},
+                {0x9A6BB0AA55653B2D, -1113}, {0xE61ACF033D1A45DF, -1087},
+                {0xAB70FE17C79AC6CA, -1060}, {0xFF77B1FCBEBCDC4F, -1034},
+                {0xBE5691EF416BD60C, -1007}, {0x8DD01FAD907FFC3C, -980},
+                {0xD3515C2831559A83, -954}, {0x9D71AC8FADA6C9B5, -927},
+                {0xEA9C227723EE8BCB, -901}, {0xAECC49914078536D, -874},
+                {0x823C12795DB6CE57, -847}, {0xC21094364DFB5637, -821},
+                {0x9096EA6F3848984F, -794}, {0xD77485CB25823AC7, -768},
+                {0xA086CFCD97BF97F4, -741}, {0xEF340A98172AACE5, -715},
+                {0xB23867FB2A35B28E, -688}, {0x84C8D4DFD2C63F3B, -661},
+                {0xC5DD44271AD3CDBA, -635}, {0x936B9FCEBB25C996, -608},
+                {0xDBAC6C247D62A584, -582}, {0xA3AB66580D5FDAF6, -555},
+                {0xF3E2F893DEC3F126, -529}, {0xB5B5ADA8AAFF80B8, -502},
+                {0x87625F056C7C4A8B, -475}, {0xC9BCFF6034C13053, -449},
+                {0x964E858C91BA2655, -422}, {0xDFF9772470297EBD, -396},
+                {0xA6DFBD9FB8E5B88F, -369}, {0xF8A95FCF88747D94, -343},
+                {0xB94470938FA89BCF, -316}, {0x8A08F0F8BF0F156B, -289},
+                {0xCDB02555653131B6, -263}, {0x993FE2C6D07B7FAC, -236},
+                {0xE45C10C42A2B3B06, -210}, {0xAA242499697392D3, -183},
+                {0xFD87B5F28300CA0E, -157}, {0xBCE5086492111AEB, -130},
+                {0x8CBCCC096F5088CC, -103}, {0xD1B71758E219652C, -77},
+                {0x9C40000000000000, -50}, {0xE8D4A51000000000, -24},
+                {0xAD78EBC5AC620000, 3}, {0x813F3978F8940984, 30},
+                {0xC097CE7BC90715B3, 56}, {0x8F7E32CE7BEA5C70, 83},
+                {0xD5D238A4ABE98068, 109}, {0x9F4F2726179A2245, 136},
+                {0xED63A231D4C4FB27, 162}, {0xB0DE65388CC8ADA8, 189},
+                {0x83C7088E1AAB65DB, 216}, {0xC45D1DF942711D9A, 242},
+                {0x924D692CA61BE758, 269}, {0xDA01EE641A708DEA, 295},
+                {0xA26DA3999AEF774A, 322}, {0xF209787BB47D6B85, 348},
+                {0xB454E4A179DD1877, 375}, {0x865B86925B9BC5C2, 402},
+                {0xC83553C5C8965D3D, 428}, {0x952AB45CFA97A0B3, 455},
+                {0xDE469FBD99A05FE3, 481}, {0xA59BC234DB398C25, 508},
+                {0xF6C69A72A3989F5C, 534}, {0xB7DCBF5354E9BECE, 561},
+                {0x88FCF317F22241E2, 588}, {0xCC20CE9BD35C78A5, 614},
+                {0x98165AF37B2153DF, 641}, {0xE2A0B5DC971F303A, 667},
+                {0xA8D9D1535CE3B396, 694}, {0xFB9B7CD9A4A7443C, 720},
+                {0xBB764C4CA7A44410, 747}, {0x8BAB8EEFB6409C1A, 774},
+                {0xD01FEF10A657842C, 800}, {0x9B10A4E5E9913129, 827},
+                {0xE7109BFBA19C0C9D, 853}, {0xAC2820D9623BF429, 880},
+                {0x80444B5E7AA7CF85, 907}, {0xBF21E44003ACDD2D, 933},
+                {0x8E679C2F5E44FF8F, 960}, {0xD433179D9C8CB841, 986},
+                {0x9E19DB92B4E31BA9, 1013}, {0xEB96BF6EBADF77D9, 1039},
+                {0xAF87023B9BF0EE6B, 1066}
+        };
+
+        double dk = (-61 - e) * 0.30102999566398114 + 347;
+        auto ik = static_cast<int>(dk);
+        if (dk - ik > 0.0)
+        {
+            ++ik;
+        }
+        auto index = static_cast<unsigned>((ik >> 3) + 1);
+        k = -(-348 + static_cast<int>(index << 3));
+        return kPowers[index];
+    }
+
+    inline void grisuRound(char* digits, int len, uint64_t delta, uint64_t rest, 
+        uint64_t tenKappa, uint64_t distance)
+    {
+        while (rest < distance && delta - rest >= tenKappa 
+            && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+        {
+            --digits[len - 1];
+            rest += tenKappa;
+        }
+    }
+
+    /**
+     * @brief   Generates the digits of the shortest number in the interval ending at @c high.
+     */
+    inline void grisuDigits(DiyFp w, DiyFp high, uint64_t delta, char* digits, int& len, 
+        int& k)
+    {
+        static const uint64_t kPow10[] = 
+        {
+            1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 
+            100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+            10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+            100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+        };
+
+        const DiyFp one{uint64_t(1) << -high.e, high.e};
+        const uint64_t distance = high.f - w.f;
+        auto p1 = static_cast<uint32_t>(high.f >> -one.e);
+        uint64_t p2 = high.f & (one.f - 1);
+
+        int kappa = 1;
+        while (kappa < 10 && p1 >= kPow10[kappa])
+        {
+            ++kappa;
+        }
+
+        len = 0;
+        while (kappa > 0)
+        {
+            auto divisor = static_cast<uint32_t>(kPow10[kappa - 1]);
+            auto digit = p1 / divisor;
+            p1 %= divisor;
+            if (digit || len)
+            {
+                digits[len++] = static_cast<char>('0' + digit);
+            }
+            --kappa;
+            uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+            if (rest <= delta)
+            {
+                k += kappa;
+                grisuRound(digits, len, delta, rest, kPow10[kappa] << -one.e, distance);
+                return;
+            }
+        }
+
+        for (;;)
+        {
+            p2 *= 10;
+            delta *= 10;
+            auto digit = static_cast<char>(p2 >> -one.e);
+            if (digit || len)
+            {
+                digits[len++] = static_cast<char>('0' + digit);
+            }
+            p2 &= one.f - 1;
+            --kappa;
+            if (p2 < delta)
+            {
+                k += kappa;
+                grisuRound(digits, len, delta, p2, one.f, 
+                    distance * (-kappa < 20 ? kPow10[-kappa] : 0));
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief   Computes the digits and decimal exponent of a short representation of a
+     *          positive, finite value that reads back as the same value (Grisu2).
+     * @param   value   The value.
+     * @param   digits  Receives the digits, at least 20 characters.
+     * @param   len     Receives the number of digits.
+     * @param   k       Receives the decimal exponent, the value is @c digits * 10^k.
+     */
+    template<typename FloatT>
+    inline void grisu2(FloatT value, char* digits, int& len, int& k)
+    {
+        DiyFp v, minus, plus;
+        grisuBoundaries(value, v, minus, plus);
+        auto power = grisuCachedPower(plus.e, k);
+        auto w = diyFpMultiply(v, power);
+        auto high = diyFpMultiply(plus, power);
+        auto low = diyFpMultiply(minus, power);
+        // Shrinks the interval by the multiplication's error, so every result is inside.
+        ++low.f;
+        --high.f;
+        grisuDigits(w, high, high.f - low.f, digits, len, k);
+    }
+
+    /**
+     * @brief   Formats digits and decimal exponent like ECMAScript's @c Number::toString, i.e.
+     *          without exponent for decimal exponents between -7 and 21.
+     */
+    inline char* formatDecimal(char* first, char* last, bool negative, const char* digits, 
+        int len, int k)
+    {
+        int point = len + k;
+        int exponent = point - 1;
+        std::ptrdiff_t size = negative;
+        if (k >= 0 && point <= 21)
+        {
+            size += point;
+        }
+        else if (point > 0 && point <= 21)
+        {
+            size += len + 1;
+        }
+        else if (point > -6 && point <= 0)
+        {
+            size += 2 - point + len;
+        }
+        else
+        {
+            auto absExponent = exponent < 0 ? -exponent : exponent;
+            size += len + (len > 1) + 1 + (exponent < 0) 
+                + (absExponent >= 100 ? 3 : absExponent >= 10 ? 2 : 1);
+        }
+        if (last - first < size)
+        {
+            return nullptr;
+        }
+
+        if (negative)
+        {
+            *first++ = '-';
+        }
+        if (k >= 0 && point <= 21)
+        {
+            std::memcpy(first, digits, len);
+            std::memset(first + len, '0', k);
+            return first + point;
+        }
+        if (point > 0 && point <= 21)
+        {
+            std::memcpy(first, digits, point);
+            first[point] = '.';
+            std::memcpy(first + point + 1, digits + point, len - point);
+            return first + len + 1;
+        }
+        if (point > -6 && point <= 0)
+        {
+            *first++ = '0';
+            *first++ = '.';
+            std::memset(first, '0', -point);
+            std::memcpy(first - point, digits, len);
+            return first - point + len;
+        }
+
+        *first++ = digits[0];
+        if (len > 1)
+        {
+            *first++ = '.';
+            std::memcpy(first, digits + 1, len - 1);
+            first += len - 1;
+        }
+        *first++ = 'e';
+        if (exponent < 0)
+        {
+            *first++ = '-';
+            exponent = -exponent;
+        }
+        if (exponent >= 100)
+        {
+            *first++ = static_cast<char>('0' + exponent / 100);
+        }
+        if (exponent >= 10)
+        {
+            *first++ = static_cast<char>('0' + exponent / 10 % 10);
+        }
+        *first++ = static_cast<char>('0' + exponent % 10);
+        return first;
+    }
+
+    /**
+     * @brief   Writes a string if it fits.
+     */
+    inline char* copyChars(char* first, char* last, const char* str)
+    {
+        auto len = std::strlen(str);
+        if (static_cast<std::size_t>(last - first) < len)
+        {
+            return nullptr;
+        }
+        std::memcpy(first, str, len);
+        return first + len;
+    }
+
+    template<typename FloatT>
+    inline char* floatToChars(char* first, char* last, FloatT value)
+    {
+        if (std::isnan(value))
+        {
+            return copyChars(first, last, "nan");
+        }
+        if (std::isinf(value))
+        {
+            return copyChars(first, last, value < 0 ? "-inf" : "inf");
+        }
+        if (value == 0)
+        {
+            return copyChars(first, last, std::signbit(value) ? "-0" : "0");
+        }
+
+        char digits[24];
+        int len, k;
+        grisu2(std::fabs(value), digits, len, k);
+        return formatDecimal(first, last, value < 0, digits, len, k);
+    }
+
+    inline char* floatToChars(char* first, char* last, long double value)
+    {
+        // Rarely used, so long doubles take the slow path of probing the C library for the
+        // shortest precision reading back as the same value.
+        char buffer[64];
+        int len = 0;
+        for (int precision = std::numeric_limits<long double>::digits10; 
+            precision <= std::numeric_limits<long double>::max_digits10; ++precision)
+        {
+            len = std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision, value);
+            if (std::strtold(buffer, nullptr) == value)
+            {
+                break;
+            }
+        }
+        if (len <= 0 || last - first < len)
+        {
+            return nullptr;
+        }
+        std::memcpy(first, buffer, len);
+        return first + len;
+    }
+
+    inline float strToFloat(const char* str, char** end, float*)
+    {
+        return std::strtof(str, end);
+    }
+
+    inline double strToFloat(const char* str, char** end, double*)
+    {
+        return std::strtod(str, end);
+    }
+
+    inline long double strToFloat(const char* str, char** end, long double*)
+    {
+        return std::strtold(str, end);
+    }
+
+    /**
+     * @brief   Compares a character range with a lower case string, ignoring case.
+     */
+    inline bool equalsIgnoreCase(const char* first, const char* last, const char* lowerStr)
+    {
+        for (; first != last; ++first, ++lowerStr)
+        {
+            if (!*lowerStr || (*first | 0x20) != *lowerStr)
+            {
+                return false;
+            }
+        }
+        return !*lowerStr;
+    }
+
+    template<typename FloatT>
+    inline bool floatFromChars(const char* first, const char* last, FloatT& value)
+    {
+        using Traits = FloatTraits<FloatT>;
+        static const FloatT kPow10[] = 
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 
+            1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char* cur = first;
+        bool negative = false;
+        if (cur != last && (*cur == '-' || *cur == '+'))
+        {
+            negative = *cur++ == '-';
+        }
+        if (cur != last && ((*cur | 0x20) == 'i' || (*cur | 0x20) == 'n'))
+        {
+            FloatT special;
+            if (equalsIgnoreCase(cur, last, "inf") || equalsIgnoreCase(cur, last, "infinity"))
+            {
+                special = std::numeric_limits<FloatT>::infinity();
+            }
+            else if (equalsIgnoreCase(cur, last, "nan"))
+            {
+                special = std::numeric_limits<FloatT>::quiet_NaN();
+            }
+            else
+            {
+                return false;
+            }
+            value = negative ? -special : special;
+            return true;
+        }
+
+        // Up to 19 significant digits are collected, a decimal exponent tracks the rest.
+        uint64_t significand = 0;
+        int numSignificant = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool anyDigits = false;
+        for (; cur != last && *cur >= '0' && *cur <= '9'; ++cur)
+        {
+            anyDigits = true;
+            if (numSignificant < 19)
+            {
+                significand = significand * 10 + (*cur - '0');
+                numSignificant += significand != 0;
+            }
+            else
+            {
+                ++exponent;
+                truncated |= *cur != '0';
+            }
+        }
+        if (cur != last && *cur == '.')
+        {
+            for (++cur; cur != last && *cur >= '0' && *cur <= '9'; ++cur)
+            {
+                anyDigits = true;
+                if (numSignificant < 19)
+                {
+                    significand = significand * 10 + (*cur - '0');
+                    numSignificant += significand != 0;
+                    --exponent;
+                }
+                else
+                {
+                    truncated |= *cur != '0';
+                }
+            }
+        }
+        if (!anyDigits)
+        {
+            return false;
+        }
+        if (cur != last && (*cur | 0x20) == 'e')
+        {
+            ++cur;
+            bool negativeExponent = false;
+            if (cur != last && (*cur == '-' || *cur == '+'))
+            {
+                negativeExponent = *cur++ == '-';
+            }
+            if (cur == last)
+            {
+                return false;
+            }
+            int explicitExponent = 0;
+            for (; cur != last && *cur >= '0' && *cur <= '9'; ++cur)
+            {
+                // Saturates, anything this large over- or underflows anyway.
+                if (explicitExponent < 100000)
+                {
+                    explicitExponent = explicitExponent * 10 + (*cur - '0');
+                }
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        if (cur != last)
+        {
+            return false;
+        }
+
+        if (significand == 0)
+        {
+            value = negative ? -FloatT(0) : FloatT(0);
+            return true;
+        }
+
+        // Exact significand and power of ten: a single, correctly rounded operation.
+        if (!truncated && significand <= Traits::kMaxExactSignificand
+            && exponent >= -Traits::kMaxExactPower && exponent <= Traits::kMaxExactPower)
+        {
+            auto result = static_cast<FloatT>(significand);
+            result = exponent < 0 ? result / kPow10[-exponent] : result * kPow10[exponent];
+            value = negative ? -result : result;
+            return true;
+        }
+
+        // Everything else is rare enough to be left to the C library, which needs a terminated
+        // copy of the already validated text. Without truncated digits, the significand and
+        // exponent represent the value exactly in a few characters, however long the text is.
+        char buffer[256];
+        std::unique_ptr<char[]> longBuffer;
+        char* text = buffer;
+        std::size_t len;
+        if (!truncated)
+        {
+            len = static_cast<std::size_t>(std::snprintf(buffer, sizeof(buffer), "%s%llue%d",
+                negative ? "-" : "", static_cast<unsigned long long>(significand), exponent));
+        }
+        else
+        {
+            // Truncated digits can't be dropped without risking an incorrectly rounded result.
+            len = static_cast<std::size_t>(last - first);
+            if (len >= sizeof(buffer))
+            {
+                longBuffer.reset(new (std::nothrow) char[len + 1]);
+                if (!longBuffer)
+                {
+                    return false;
+                }
+                text = longBuffer.get();
+            }
+            std::memcpy(text, first, len);
+            text[len] = '\0';
+        }
+
+        char* end;
+        auto savedErrno = errno;
+        errno = 0;
+        auto result = strToFloat(text, &end, static_cast<FloatT*>(nullptr));
+        bool overflow = errno == ERANGE && std::isinf(result);
+        errno = savedErrno;
+        if (end != text + len || overflow)
+        {
+            return false;
+        }
+        value = result;
+        return true;
+    }
+
+    template<typename IntT>
+    inline bool isNegative(IntT value, std::true_type /*isSigned*/)
+    {
+        return value < 0;
+    }
+
+    template<typename IntT>
+    inline bool isNegative(IntT /*value*/, std::false_type /*isSigned*/)
+    {
+        return false;
+    }
+} // namespace internal
+
+// ============================================================================================== //
+// [toChars & fromChars]                                                                          //
+// ============================================================================================== //
+
+/**
+ * @brief   Writes the decimal representation of an integer into a buffer.
+ * @param   first   The start of the buffer.
+ * @param   last    The end of the buffer.
+ * @param   value   The value.
+ * @return  The end of the written characters or @c nullptr if the buffer is too small. No
+ *          terminating null character is written.
+ */
+template<typename IntT, 
+    std::enable_if_t<std::is_integral<IntT>::value && !std::is_same<IntT, bool>::value, int> = 0>
+inline char* toChars(char* first, char* last, IntT value)
+{
+    using UnsignedT = std::make_unsigned_t<IntT>;
+    bool negative = internal::isNegative(value, std::is_signed<IntT>());
+    auto absValue = static_cast<UnsignedT>(value);
+    if (negative)
+    {
+        absValue = static_cast<UnsignedT>(UnsignedT(0) - absValue);
+    }
+
+    char digits[24];
+    char* digitsEnd = digits + sizeof(digits);
+    char* cur = digitsEnd;
+    do
+    {
+        *--cur = static_cast<char>('0' + absValue % 10);
+        absValue = static_cast<UnsignedT>(absValue / 10);
+    } while (absValue);
+
+    auto len = digitsEnd - cur;
+    if (last - first < len + negative)
+    {
+        return nullptr;
+    }
+    if (negative)
+    {
+        *first++ = '-';
+    }
+    std::memcpy(first, cur, len);
+    return first + len;
+}
+
+/**
+ * @brief   Writes the shortest decimal representation of a floating point value reading back as
+ *          the same value into a buffer.
+ * @param   first   The start of the buffer.
+ * @param   last    The end of the buffer.
+ * @param   value   The value.
+ * @return  The end of the written characters or @c nullptr if the buffer is too small. No
+ *          terminating null character is written.
+ *
+ * @c float and @c double use the Grisu2 algorithm, which finds the shortest representation for
+ * the vast majority of values and a slightly longer one, still reading back exactly, for the
+ * rest. Like ECMAScript's @c Number::toString, an exponent is used for very small and large
+ * values only, e.g. @c 0.1, @c 100 and @c 1e21. Infinities and NaN are written as @c inf,
+ * @c -inf and @c nan.
+ */
+template<typename FloatT, std::enable_if_t<std::is_floating_point<FloatT>::value, int> = 0>
+inline char* toChars(char* first, char* last, FloatT value)
+{
+    return internal::floatToChars(first, last, value);
+}
+
+/**
+ * @brief   Parses the decimal representation of an integer.
+ * @param   first   The start of the text.
+ * @param   last    The end of the text.
+ * @param   value   Receives the value on success.
+ * @return  @c true on success, @c false if the text is no valid number or out of range.
+ *
+ * The whole text has to be consumed: an optional minus sign for signed types followed by
+ * decimal digits, no whitespace.
+ */
+template<typename IntT, 
+    std::enable_if_t<std::is_integral<IntT>::value && !std::is_same<IntT, bool>::value, int> = 0>
+inline bool fromChars(const char* first, const char* last, IntT& value)
+{
+    using UnsignedT = std::make_unsigned_t<IntT>;
+    bool negative = false;
+    if (std::is_signed<IntT>::value && first != last && *first == '-')
+    {
+        negative = true;
+        ++first;
+    }
+    if (first == last)
+    {
+        return false;
+    }
+
+    auto limit = static_cast<UnsignedT>(std::numeric_limits<IntT>::max());
+    if (negative)
+    {
+        limit = static_cast<UnsignedT>(limit + 1);
+    }
+    UnsignedT result = 0;
+    for (; first != last; ++first)
+    {
+        auto digit = static_cast<unsigned>(*first - '0');
+        if (digit > 9 || result > (limit - digit) / 10)
+        {
+            return false;
+        }
+        result = static_cast<UnsignedT>(result * 10 + digit);
+    }
+    value = static_cast<IntT>(negative ? UnsignedT(0) - result : result);
+    return true;
+}
+
+/**
+ * @brief   Parses the decimal representation of a floating point value.
+ * @param   first   The start of the text.
+ * @param   last    The end of the text.
+ * @param   value   Receives the correctly rounded value on success.
+ * @return  @c true on success, @c false if the text is no valid number or overflows.
+ *
+ * The whole text has to be consumed: an optional sign, digits with an optional decimal point
+ * and an optional exponent, or @c inf, @c infinity or @c nan, ignoring case. No whitespace and no
+ * hexadecimal notation is accepted. Numbers with exactly representable significands and small
+ * exponents are converted without the C library. Texts of 256 characters or more that have more
+ * than 19 significant digits are the only ones copied to the heap.
+ */
+template<typename FloatT, std::enable_if_t<std::is_floating_point<FloatT>::value, int> = 0>
+inline bool fromChars(const char* first, const char* last, FloatT& value)
+{
+    return internal::floatFromChars(first, last, value);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_CHARCONV_HPP
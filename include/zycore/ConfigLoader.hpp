@@ -0,0 +1,131 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_CONFIGLOADER_HPP
+#define ZYCORE_CONFIGLOADER_HPP
+
+#ifdef ZYCORE_HEADER_ONLY
+#   error "This file cannot be used in header-only mode."
+#endif // ZYCORE_HEADER_ONLY
+
+#include "zycore/MetaClass.hpp"
+#include "zycore/ThreadPool.hpp"
+
+#include <functional>
+#include <string>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [ConfigLoader]                                                                                 //
+// ============================================================================================== //
+
+/**
+ * @brief   Applies property values from a text configuration to reflectable objects.
+ *
+ * Two formats are understood, told apart by the first character of the text. Key/value
+ * configurations assign one property per line, either as @c objectName.propertyName = value
+ * or as @c propertyName = value below an @c [objectName] section header. Lines starting with
+ * @c # or @c ; are comments. JSON-like configurations are a single object whose members are
+ * either @c "objectName.propertyName": value pairs or @c "objectName": { ... } objects holding
+ * the properties of an object. Keys may be left unquoted in both.
+ *
+ * Values are either quoted strings, which may use JSON escapes, or taken verbatim up to the end
+ * of the line (key/value) or the next separator (JSON-like). They are applied using
+ * @c PropertyBase::tryFromChars, or @c PropertyBase::fromString for properties not supporting
+ * it. Values @c tryFromChars rejects are reported rather than passed on to @c fromString.
+ *
+ * The text is parsed and all targets are resolved in a single pass on the calling thread, so
+ * syntax errors and unknown objects or properties are reported before any value is applied.
+ * The values are then applied in parallel, with the objects partitioned across the tasks of a
+ * thread pool. Values for the same object are applied in the order they appear in, values for
+ * different objects concurrently, so setters must not touch other objects without
+ * synchronization.
+ */
+class ConfigLoader : public NonCopyable
+{
+public:
+    /**
+     * @brief   Resolves an object name to the object.
+     */
+    using Resolver = std::function<ReflectableObject*(NameRef)>;
+private:
+    ThreadPool& m_pool;
+    Resolver m_resolver;
+public:
+    /**
+     * @brief   Constructor. Resolves objects using the @c ObjectRegistry.
+     * @param   pool    The pool the values are applied on.
+     */
+    explicit ConfigLoader(ThreadPool& pool = ThreadPool::global());
+    /**
+     * @brief   Sets the routine used to look objects up by name.
+     * @param   resolver    The resolver, returning @c nullptr for unknown names.
+     */
+    void setResolver(Resolver resolver);
+    /**
+     * @brief   Applies a configuration.
+     * @param   first   The first character of the configuration text.
+     * @param   last    The end of the configuration text.
+     * @return  The number of values applied.
+     * @throws  InvalidUsage if the configuration is malformed, refers to unknown objects or
+     *                       properties, or contains values the properties reject. Values are
+     *                       only applied if the configuration could be parsed, but all valid
+     *                       ones are applied even if others are rejected. The message names the
+     *                       line of the first error.
+     */
+    std::size_t load(const char* first, const char* last);
+    /**
+     * @overload
+     */
+    std::size_t load(const std::string& text);
+    /**
+     * @brief   Applies a configuration file.
+     * @param   path    The path of the file.
+     * @return  The number of values applied.
+     * @throws  OSException if the file could not be read.
+     * @throws  InvalidUsage see @c load.
+     */
+    std::size_t loadFile(const std::string& path);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [ConfigLoader]                                                //
+// ============================================================================================== //
+
+inline void ConfigLoader::setResolver(Resolver resolver)
+{
+    m_resolver = std::move(resolver);
+}
+
+inline std::size_t ConfigLoader::load(const std::string& text)
+{
+    return load(text.data(), text.data() + text.size());
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_CONFIGLOADER_HPP
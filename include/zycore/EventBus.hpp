@@ -0,0 +1,554 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_EVENTBUS_HPP
+#define ZYCORE_EVENTBUS_HPP
+
+#include "zycore/EventLoop.hpp"
+#include "zycore/Exceptions.hpp"
+#include "zycore/MpmcQueue.hpp"
+#include "zycore/SignalObject.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// Internal helpers                                                                               //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Hands out dense event type IDs.
+     */
+    inline std::size_t nextEventTypeId()
+    {
+        static std::atomic<std::size_t> counter(0);
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief   Gets the ID of an event type, assigned once per type and process.
+     */
+    template<typename EventT>
+    std::size_t eventTypeId()
+    {
+        static const std::size_t id = nextEventTypeId();
+        return id;
+    }
+
+    /**
+     * @brief   Type-erased topic of an event bus.
+     */
+    class TopicBase : public NonCopyable
+    {
+    public:
+        virtual ~TopicBase() = default;
+    };
+
+    template<typename EventT>
+    class Mailbox;
+
+    /**
+     * @brief   Topic of an event bus, one per event type.
+     *
+     * Subscribers without an event loop are connected to @c signal. The mailboxes of the others
+     * are kept in an immutable list that is replaced as a whole on changes, so publishers only
+     * hold a lock for as long as it takes to grab a reference to the current list.
+     */
+    template<typename EventT>
+    class Topic : public TopicBase
+    {
+    public:
+        struct Subscription
+        {
+            SlotHandle handle;
+            SignalObject* subscriber;
+            SlotHandle destroyHandle;
+            std::shared_ptr<Mailbox<EventT>> mailbox;
+        };
+        using Subscriptions = std::vector<Subscription>;
+    public:
+        Signal<const EventT&> signal;
+        // Serializes replacing the subscription list.
+        std::mutex mutex;
+        std::shared_ptr<const Subscriptions> subscriptions;
+        SlotHandle lastHandle = 0;
+    };
+
+    /**
+     * @brief   Queue of events published to a subscriber, drained on the subscriber's thread.
+     */
+    template<typename EventT>
+    class Mailbox : public std::enable_shared_from_this<Mailbox<EventT>>
+    {
+        MpmcQueue<EventT> m_queue;
+        std::function<void(const EventT&)> m_func;
+        EventLoop* m_loop;
+        std::atomic<bool> m_drainPosted;
+        std::atomic<bool> m_alive;
+    public:
+        /**
+         * @brief   Constructor.
+         * @param   loop        The event loop to drain from.
+         * @param   func        The subscriber's handler.
+         * @param   capacity    The queue capacity.
+         */
+        Mailbox(EventLoop* loop, std::function<void(const EventT&)> func, std::size_t capacity);
+
+        /**
+         * @brief   Queues an event, posting a drain to the loop unless one is pending.
+         * @param   event   The event.
+         * @return  @c false if the queue stayed full and the event was dropped, else @c true.
+         * @remarks This routine is thread-safe.
+         *
+         * A full queue is drained right away when called from the loop's thread. Other threads
+         * give the loop a short while to catch up before dropping the event.
+         */
+        bool push(const EventT& event);
+
+        /**
+         * @brief   Delivers the queued events. Must be called from the loop's thread.
+         */
+        void drain();
+
+        /**
+         * @brief   Discards all further events, called when the subscription ends.
+         */
+        void kill();
+
+        /**
+         * @brief   Determines whether the subscriber still exists.
+         * @return  @c true until @c kill is called, then @c false.
+         */
+        bool isAlive() const;
+    };
+} // namespace internal
+
+// ============================================================================================== //
+// [EventBus]                                                                                     //
+// ============================================================================================== //
+
+/**
+ * @brief   Publish/subscribe hub dispatching events by their type.
+ *          
+ * Every event type gets a topic, identified by an ID handed out once per type instead of a 
+ * string. Subscribers are signal objects; their subscriptions end with them, just like any 
+ * other connection bound to a signal object.
+ * 
+ * Publishing copies the event into a lock-free queue per subscriber, without holding any lock
+ * while doing so. Subscribers with thread affinity drain their queue on their event loop, a 
+ * single event loop post covering all events published until the drain runs. Subscribers 
+ * without an event loop are called directly by the publisher. If a subscriber's queue is full, 
+ * the publisher briefly waits for it to drain and then drops the event for that subscriber, so 
+ * a stalled subscriber can't block publishers.
+ * 
+ * Events have to be copyable and default-constructible.
+ */
+class EventBus : public NonCopyable
+{
+    static const std::size_t kMaxTopics = 1024;
+    // Marks handles of mailbox subscriptions, bits signals never use in their handles.
+    static const SlotHandle kMailboxHandle = SlotHandle(1) << (sizeof(SlotHandle) * 8 - 1);
+
+    std::size_t m_queueCapacity;
+    // Created on first use, also from const lookups.
+    mutable std::atomic<internal::TopicBase*> m_topics[kMaxTopics];
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   queueCapacity   The number of events that can be queued per subscriber.
+     */
+    explicit EventBus(std::size_t queueCapacity = 1024);
+
+    /**
+     * @brief   Destructor. Ends all subscriptions, events already queued are still delivered.
+     */
+    ~EventBus();
+public: // Public interface.
+    /**
+     * @brief   Gets the process-wide event bus.
+     * @return  The event bus.
+     * @remarks This routine is thread-safe.
+     */
+    static EventBus& global();
+
+    /**
+     * @brief   Subscribes to an event type.
+     * @tparam  EventT      The event type.
+     * @param   subscriber  The subscribing object. Events are delivered to the event loop the
+     *                      object has affinity to at the time of the call.
+     * @param   func        The handler, called with a constant reference to the event.
+     * @return  A handle to unsubscribe with.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename EventT, typename FuncT>
+    SlotHandle subscribe(SignalObject* subscriber, FuncT&& func);
+
+    /**
+     * @brief   Subscribes a member function to the event type it takes.
+     * @param   subscriber  The subscribing object.
+     * @param   member      The member function.
+     * @return  A handle to unsubscribe with.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename ObjectT, typename EventT>
+    SlotHandle subscribe(ObjectT* subscriber, void(ObjectT::*member)(const EventT&));
+
+    /**
+     * @brief   Ends a subscription. Events already queued for it are discarded.
+     * @tparam  EventT  The event type.
+     * @param   handle  The handle returned by @c subscribe.
+     * @return  @c true on success, @c false if the subscription didn't exist.
+     * @remarks This routine is thread-safe, but must not race with the destruction of the 
+     *          subscriber.
+     */
+    template<typename EventT>
+    bool unsubscribe(SlotHandle handle);
+
+    /**
+     * @brief   Publishes an event to all subscribers of its type.
+     * @param   event   The event.
+     * @return  The number of subscribers the event was dropped for as their queue was full.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename EventT>
+    std::size_t publish(const EventT& event);
+
+    /**
+     * @brief   Gets the number of subscribers to an event type.
+     * @tparam  EventT  The event type.
+     * @return  The number of subscribers.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename EventT>
+    std::size_t numSubscribers() const;
+private:
+    /**
+     * @brief   Gets the topic of an event type.
+     * @param   create  Create the topic if it doesn't exist yet.
+     * @return  The topic or @c nullptr if it doesn't exist and @c create is @c false.
+     */
+    template<typename EventT>
+    internal::Topic<EventT>* topic(bool create) const;
+
+    /**
+     * @brief   Replaces the mailbox subscriptions of a topic.
+     * @param   eventTopic  The topic. Its mutex has to be held.
+     * @param   keep        Called for every current subscription, returns whether to keep it.
+     * @param   added       A subscription to add or @c nullptr.
+     *
+     * Subscriptions of destroyed subscribers are dropped as well.
+     */
+    template<typename EventT, typename FuncT>
+    static void updateSubscriptions(internal::Topic<EventT>& eventTopic, FuncT keep, 
+        const typename internal::Topic<EventT>::Subscription* added);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::Mailbox]                                           //
+// ============================================================================================== //
+
+namespace internal
+{
+
+template<typename EventT>
+inline Mailbox<EventT>::Mailbox(EventLoop* loop, std::function<void(const EventT&)> func, 
+    std::size_t capacity)
+    : m_queue(capacity)
+    , m_func(std::move(func))
+    , m_loop(loop)
+    , m_drainPosted(false)
+    , m_alive(true)
+{}
+
+template<typename EventT>
+inline bool Mailbox<EventT>::push(const EventT& event)
+{
+    if (!m_alive.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    const unsigned kMaxRetries = 64;
+    for (unsigned retries = 0; !m_queue.tryPush(event); ++retries)
+    {
+        if (m_loop->isCurrentThread())
+        {
+            drain();
+        }
+        else if (retries < kMaxRetries)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (!m_drainPosted.exchange(true, std::memory_order_acq_rel))
+    {
+        auto self = this->shared_from_this();
+        m_loop->post([self] { self->drain(); });
+    }
+    return true;
+}
+
+template<typename EventT>
+inline void Mailbox<EventT>::drain()
+{
+    // Events pushed after clearing the flag post another drain, the ones pushed before are 
+    // visible below as their publishers' exchange synchronizes with ours. Bounding the batch 
+    // keeps busy publishers from starving the loop.
+    m_drainPosted.exchange(false, std::memory_order_acq_rel);
+
+    EventT event;
+    for (auto i = m_queue.capacity(); i && m_queue.tryPop(event); --i)
+    {
+        if (m_alive.load(std::memory_order_acquire))
+        {
+            m_func(event);
+        }
+    }
+}
+
+template<typename EventT>
+inline void Mailbox<EventT>::kill()
+{
+    m_alive.store(false, std::memory_order_release);
+}
+
+template<typename EventT>
+inline bool Mailbox<EventT>::isAlive() const
+{
+    return m_alive.load(std::memory_order_acquire);
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [EventBus]                                                    //
+// ============================================================================================== //
+
+inline EventBus::EventBus(std::size_t queueCapacity)
+    : m_queueCapacity(queueCapacity)
+{
+    for (auto& curTopic : m_topics)
+    {
+        curTopic.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+inline EventBus::~EventBus()
+{
+    for (auto& curTopic : m_topics)
+    {
+        delete curTopic.load(std::memory_order_acquire);
+    }
+}
+
+inline EventBus& EventBus::global()
+{
+    static EventBus bus;
+    return bus;
+}
+
+template<typename EventT, typename FuncT>
+inline SlotHandle EventBus::subscribe(SignalObject* subscriber, FuncT&& func)
+{
+    auto eventTopic = topic<EventT>(true);
+    auto loop = subscriber->eventLoop();
+    if (!loop)
+    {
+        return eventTopic->signal.connect(subscriber, std::forward<FuncT>(func), 
+            ConnectionType::kDirect);
+    }
+
+    typename internal::Topic<EventT>::Subscription subscription;
+    subscription.subscriber = subscriber;
+    subscription.mailbox = std::make_shared<internal::Mailbox<EventT>>(
+        loop, std::forward<FuncT>(func), m_queueCapacity);
+    auto mailbox = subscription.mailbox;
+    subscription.destroyHandle = subscriber->sigDestroy.connect(subscriber, 
+        [mailbox] { mailbox->kill(); }, ConnectionType::kDirect);
+
+    std::lock_guard<std::mutex> lock(eventTopic->mutex);
+    subscription.handle = kMailboxHandle | ++eventTopic->lastHandle;
+    updateSubscriptions(*eventTopic, [](const auto&) { return true; }, &subscription);
+    return subscription.handle;
+}
+
+template<typename ObjectT, typename EventT>
+inline SlotHandle EventBus::subscribe(ObjectT* subscriber, void(ObjectT::*member)(const EventT&))
+{
+    static_assert(std::is_base_of<SignalObject, ObjectT>::value,
+        "type has to be derived from SignalObject");
+    return subscribe<EventT>(subscriber, 
+        [subscriber, member](const EventT& event) { (subscriber->*member)(event); });
+}
+
+template<typename EventT>
+inline bool EventBus::unsubscribe(SlotHandle handle)
+{
+    auto eventTopic = topic<EventT>(false);
+    if (!eventTopic)
+    {
+        return false;
+    }
+    if (!(handle & kMailboxHandle))
+    {
+        return eventTopic->signal.disconnect(handle);
+    }
+
+    typename internal::Topic<EventT>::Subscription removed;
+    {
+        std::lock_guard<std::mutex> lock(eventTopic->mutex);
+        updateSubscriptions(*eventTopic, [&](const auto& subscription)
+        {
+            if (subscription.handle != handle)
+            {
+                return true;
+            }
+            removed = subscription;
+            return false;
+        }, nullptr);
+    }
+
+    // Disconnected without holding the topic's lock, the subscriber's signal takes its own.
+    if (!removed.mailbox || !removed.mailbox->isAlive())
+    {
+        return false;
+    }
+    // Publishers that grabbed the old list may still queue events and post drains, which must
+    // not reach the subscriber once nothing tracks its destruction anymore.
+    removed.mailbox->kill();
+    removed.subscriber->sigDestroy.disconnect(removed.destroyHandle);
+    return true;
+}
+
+template<typename EventT>
+inline std::size_t EventBus::publish(const EventT& event)
+{
+    auto eventTopic = topic<EventT>(false);
+    if (!eventTopic)
+    {
+        return 0;
+    }
+
+    std::size_t numDropped = 0;
+    if (auto subscriptions = std::atomic_load(&eventTopic->subscriptions))
+    {
+        for (const auto& curSubscription : *subscriptions)
+        {
+            numDropped += !curSubscription.mailbox->push(event);
+        }
+    }
+    eventTopic->signal.emit(event);
+    return numDropped;
+}
+
+template<typename EventT>
+inline std::size_t EventBus::numSubscribers() const
+{
+    auto eventTopic = topic<EventT>(false);
+    if (!eventTopic)
+    {
+        return 0;
+    }
+
+    auto numSubscribers = eventTopic->signal.numSlots();
+    if (auto subscriptions = std::atomic_load(&eventTopic->subscriptions))
+    {
+        for (const auto& curSubscription : *subscriptions)
+        {
+            numSubscribers += curSubscription.mailbox->isAlive();
+        }
+    }
+    return numSubscribers;
+}
+
+template<typename EventT, typename FuncT>
+inline void EventBus::updateSubscriptions(internal::Topic<EventT>& eventTopic, FuncT keep, 
+    const typename internal::Topic<EventT>::Subscription* added)
+{
+    using Subscriptions = typename internal::Topic<EventT>::Subscriptions;
+    auto current = std::atomic_load(&eventTopic.subscriptions);
+    std::shared_ptr<Subscriptions> updated(new Subscriptions);
+    if (current)
+    {
+        updated->reserve(current->size() + 1);
+        for (const auto& curSubscription : *current)
+        {
+            if (keep(curSubscription) && curSubscription.mailbox->isAlive())
+            {
+                updated->push_back(curSubscription);
+            }
+        }
+    }
+    if (added)
+    {
+        updated->push_back(*added);
+    }
+    std::atomic_store(&eventTopic.subscriptions, 
+        std::shared_ptr<const Subscriptions>(std::move(updated)));
+}
+
+template<typename EventT>
+inline internal::Topic<EventT>* EventBus::topic(bool create) const
+{
+    auto id = internal::eventTypeId<EventT>();
+    if (id >= kMaxTopics)
+    {
+        ZYCORE_RAISE(OutOfBounds, "too many event types");
+    }
+
+    auto& slot = m_topics[id];
+    auto existing = slot.load(std::memory_order_acquire);
+    if (!existing && create)
+    {
+        auto created = new internal::Topic<EventT>;
+        if (slot.compare_exchange_strong(existing, created, std::memory_order_acq_rel))
+        {
+            existing = created;
+        }
+        else
+        {
+            delete created;
+        }
+    }
+    return static_cast<internal::Topic<EventT>*>(existing);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_EVENTBUS_HPP
@@ -0,0 +1,424 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_EVENTLOOP_HPP
+#define ZYCORE_EVENTLOOP_HPP
+
+#include "zycore/Utils.hpp"
+
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cassert>
+
+namespace zycore
+{
+
+class EventLoop;
+
+// ============================================================================================== //
+// [internal::LoopAffinity]                                                                       //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Thread affinity of an object, reset when the event loop is destroyed.
+     *
+     * Registered with the loop it refers to, so the loop can reset it instead of leaving a
+     * dangling pointer behind. Changing or destroying the affinity must not race with the
+     * destruction of the loop it currently refers to.
+     */
+    class LoopAffinity : public NonCopyable
+    {
+        friend class zycore::EventLoop;
+    private:
+        std::atomic<EventLoop*> m_loop;
+        // Guarded by the affinity mutex of the loop.
+        LoopAffinity* m_prev;
+        LoopAffinity* m_next;
+    public:
+        /**
+         * @brief   Constructor.
+         * @param   loop    The event loop, may be @c nullptr.
+         */
+        explicit LoopAffinity(EventLoop* loop);
+
+        /**
+         * @brief   Destructor. Unregisters from the loop.
+         */
+        ~LoopAffinity();
+
+        /**
+         * @brief   Gets the event loop.
+         * @return  The loop or @c nullptr if there is none or it was destroyed.
+         * @remarks This routine is thread-safe.
+         */
+        EventLoop* loop() const;
+
+        /**
+         * @brief   Changes the event loop.
+         * @param   loop    The new event loop, may be @c nullptr.
+         * @remarks This routine is thread-safe.
+         */
+        void setLoop(EventLoop* loop);
+    private:
+        static std::mutex& changeMutex();
+    };
+} // namespace internal
+
+// ============================================================================================== //
+// [EventLoop]                                                                                    //
+// ============================================================================================== //
+
+/**
+ * @brief   Per-thread queue of deferred events, used for queued signal delivery.
+ *
+ * An event loop is bound to the thread that constructs it and becomes that thread's current
+ * loop (see @c current) until it is destroyed. Any thread may @c post events, only the owning
+ * thread is supposed to process them. Events are drained in batches: @c processEvents takes
+ * everything queued at the time of the call with a single lock acquisition and runs it without
+ * holding the lock, so producers are never blocked by slow consumers.
+ *
+ * Objects with affinity to a loop (see @c SignalObject::setEventLoop) lose it when the loop is
+ * destroyed, further queued calls to them are made directly. Posting to a loop that is being
+ * destroyed is not allowed though, so emissions on other threads that may queue calls to it
+ * have to be over by then.
+ */
+class EventLoop : public NonCopyable
+{
+public:
+    using Event = std::function<void()>;
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_eventPosted;
+    std::vector<Event> m_pending;
+    std::vector<Event> m_batch;
+    std::thread::id m_threadId;
+    EventLoop* m_previous;
+    bool m_quit;
+    std::mutex m_affinityMutex;
+    internal::LoopAffinity* m_affinities;
+private:
+    friend class internal::LoopAffinity;
+
+    static EventLoop*& currentRef();
+
+    /**
+     * @brief   Registers an affinity to this loop.
+     */
+    void attach(internal::LoopAffinity* affinity);
+
+    /**
+     * @brief   Unregisters an affinity from this loop unless the loop already reset it.
+     */
+    void detach(internal::LoopAffinity* affinity);
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor. Binds the loop to the calling thread.
+     */
+    EventLoop();
+
+    /**
+     * @brief   Destructor. Pending events are discarded, affinities to the loop are reset.
+     * @remarks Must be called from the owning thread.
+     */
+    ~EventLoop();
+public: // Public interface.
+    /**
+     * @brief   Gets the event loop of the calling thread.
+     * @return  The loop or @c nullptr if the thread has none.
+     */
+    static EventLoop* current();
+
+    /**
+     * @brief   Gets the ID of the thread owning this loop.
+     * @return  The thread ID.
+     */
+    std::thread::id threadId() const;
+
+    /**
+     * @brief   Determines whether the calling thread is the one owning this loop.
+     * @return  @c true if called from the owning thread, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isCurrentThread() const;
+
+    /**
+     * @brief   Queues an event for execution on the owning thread.
+     * @param   event   The event to queue.
+     * @remarks This routine is thread-safe.
+     */
+    void post(Event event);
+
+    /**
+     * @brief   Runs all events queued at the time of the call.
+     * @return  The number of events processed.
+     *
+     * Events posted while the batch is being processed are deferred to the next call.
+     */
+    std::size_t processEvents();
+
+    /**
+     * @brief   Blocks until events are queued, @c quit was called or the timeout elapsed.
+     * @param   timeout The maximum time to wait.
+     * @return  @c true if events are pending, else @c false.
+     */
+    bool waitForEvents(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief   Processes events until @c quit is called.
+     */
+    void run();
+
+    /**
+     * @brief   Makes @c run return after the current batch.
+     * @remarks This routine is thread-safe.
+     */
+    void quit();
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::LoopAffinity]                                      //
+// ============================================================================================== //
+
+namespace internal
+{
+
+inline LoopAffinity::LoopAffinity(EventLoop* loop)
+    : m_loop(nullptr)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+{
+    if (loop)
+    {
+        m_loop.store(loop, std::memory_order_relaxed);
+        loop->attach(this);
+    }
+}
+
+inline LoopAffinity::~LoopAffinity()
+{
+    if (auto loop = m_loop.load(std::memory_order_acquire))
+    {
+        loop->detach(this);
+    }
+}
+
+inline EventLoop* LoopAffinity::loop() const
+{
+    return m_loop.load(std::memory_order_acquire);
+}
+
+inline void LoopAffinity::setLoop(EventLoop* loop)
+{
+    // Keeps concurrent changes from registering the affinity with two loops at once.
+    std::lock_guard<std::mutex> lock(changeMutex());
+    auto previous = m_loop.load(std::memory_order_acquire);
+    if (previous == loop)
+    {
+        return;
+    }
+    if (previous)
+    {
+        previous->detach(this);
+    }
+    m_loop.store(loop, std::memory_order_release);
+    if (loop)
+    {
+        loop->attach(this);
+    }
+}
+
+inline std::mutex& LoopAffinity::changeMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [EventLoop]                                                   //
+// ============================================================================================== //
+
+inline EventLoop*& EventLoop::currentRef()
+{
+    static thread_local EventLoop* current = nullptr;
+    return current;
+}
+
+inline EventLoop::EventLoop()
+    : m_threadId(std::this_thread::get_id())
+    , m_previous(currentRef())
+    , m_quit(false)
+    , m_affinities(nullptr)
+{
+    currentRef() = this;
+}
+
+inline EventLoop::~EventLoop()
+{
+    assert(isCurrentThread());
+    if (currentRef() == this)
+    {
+        currentRef() = m_previous;
+    }
+
+    std::lock_guard<std::mutex> lock(m_affinityMutex);
+    for (auto affinity = m_affinities; affinity; affinity = affinity->m_next)
+    {
+        affinity->m_loop.store(nullptr, std::memory_order_release);
+    }
+    m_affinities = nullptr;
+}
+
+inline void EventLoop::attach(internal::LoopAffinity* affinity)
+{
+    std::lock_guard<std::mutex> lock(m_affinityMutex);
+    affinity->m_prev = nullptr;
+    affinity->m_next = m_affinities;
+    if (m_affinities)
+    {
+        m_affinities->m_prev = affinity;
+    }
+    m_affinities = affinity;
+}
+
+inline void EventLoop::detach(internal::LoopAffinity* affinity)
+{
+    std::lock_guard<std::mutex> lock(m_affinityMutex);
+    if (affinity->m_loop.load(std::memory_order_relaxed) != this)
+    {
+        return;
+    }
+    (affinity->m_prev ? affinity->m_prev->m_next : m_affinities) = affinity->m_next;
+    if (affinity->m_next)
+    {
+        affinity->m_next->m_prev = affinity->m_prev;
+    }
+    affinity->m_prev = affinity->m_next = nullptr;
+}
+
+inline EventLoop* EventLoop::current()
+{
+    return currentRef();
+}
+
+inline std::thread::id EventLoop::threadId() const
+{
+    return m_threadId;
+}
+
+inline bool EventLoop::isCurrentThread() const
+{
+    return m_threadId == std::this_thread::get_id();
+}
+
+inline void EventLoop::post(Event event)
+{
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        wasEmpty = m_pending.empty();
+        m_pending.emplace_back(std::move(event));
+    }
+
+    // Only the first event of a batch needs to wake the loop up.
+    if (wasEmpty)
+    {
+        m_eventPosted.notify_one();
+    }
+}
+
+inline std::size_t EventLoop::processEvents()
+{
+    assert(isCurrentThread());
+
+    // Events may recursively process the loop, so the batch buffer has to be private to this
+    // invocation. Swapping the buffers back afterwards keeps the allocations alive.
+    std::vector<Event> batch;
+    batch.swap(m_batch);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        batch.swap(m_pending);
+    }
+
+    for (auto& curEvent : batch)
+    {
+        curEvent();
+    }
+
+    auto numProcessed = batch.size();
+    batch.clear();
+    if (batch.capacity() > m_batch.capacity())
+    {
+        batch.swap(m_batch);
+    }
+    return numProcessed;
+}
+
+inline bool EventLoop::waitForEvents(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_eventPosted.wait_for(lock, timeout, [this]
+    {
+        return !m_pending.empty() || m_quit;
+    }) && !m_pending.empty();
+}
+
+inline void EventLoop::run()
+{
+    assert(isCurrentThread());
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_eventPosted.wait(lock, [this] { return !m_pending.empty() || m_quit; });
+            if (m_quit)
+            {
+                m_quit = false;
+                return;
+            }
+        }
+        processEvents();
+    }
+}
+
+inline void EventLoop::quit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_eventPosted.notify_all();
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_EVENTLOOP_HPP
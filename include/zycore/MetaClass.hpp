@@ -0,0 +1,514 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_METACLASS_HPP
+#define ZYCORE_METACLASS_HPP
+
+#ifdef ZYCORE_HEADER_ONLY
+#   error "This file cannot be used in header-only mode."
+#endif // ZYCORE_HEADER_ONLY
+
+#include "zycore/Utils.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zycore
+{
+
+class MetaClass;
+class MetaProperty;
+class PropertyBase;
+class ReflectableObject;
+
+// ============================================================================================== //
+// [NameRef]                                                                                      //
+// ============================================================================================== //
+
+/**
+ * @brief   Non-owning reference to a name, allowing lookups by name without allocating strings.
+ */
+class NameRef
+{
+    const char* m_data;
+    std::size_t m_size;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   name    The null-terminated name.
+     */
+    NameRef(const char* name);
+
+    /**
+     * @brief   Constructor.
+     * @param   name    The name.
+     */
+    NameRef(const std::string& name);
+
+    /**
+     * @brief   Constructor.
+     * @param   data    The characters of the name, not necessarily null-terminated.
+     * @param   size    The number of characters.
+     */
+    constexpr NameRef(const char* data, std::size_t size);
+
+    /**
+     * @brief   Gets the characters of the name.
+     * @return  The characters, not necessarily null-terminated.
+     */
+    constexpr const char* data() const;
+
+    /**
+     * @brief   Gets the number of characters of the name.
+     * @return  The size.
+     */
+    constexpr std::size_t size() const;
+
+    /**
+     * @brief   Computes the 64 bit FNV-1a hash of the name.
+     * @return  The hash.
+     */
+    constexpr uint64_t hash() const;
+
+    /**
+     * @brief   Compares the name with a string.
+     * @param   other   The string.
+     * @return  @c true if both are equal, else @c false.
+     */
+    bool operator == (const std::string& other) const;
+};
+
+namespace internal
+{
+    /**
+     * @brief   Open addressing hash table mapping property names to descriptors, along with a
+     *          table mapping property indices to them.
+     */
+    struct PropertyIndex
+    {
+        struct Bucket
+        {
+            uint64_t hash;
+            const MetaProperty* property;
+        };
+
+        /**
+         * @brief   The buckets, a power of two of them, at most half of them used.
+         */
+        std::vector<Bucket> buckets;
+        /**
+         * @brief   The descriptors by property index.
+         */
+        std::vector<const MetaProperty*> properties;
+        /**
+         * @brief   The number of properties of the class when the index was built.
+         */
+        std::size_t numProperties;
+    };
+} // namespace internal
+
+// ============================================================================================== //
+// [MetaProperty]                                                                                 //
+// ============================================================================================== //
+
+/**
+ * @brief   Class-level descriptor of a property.
+ *
+ * Created once per property member of a class, when the first instance of the class constructs
+ * the property, and shared by all instances. Locates the property of an instance through the
+ * property's offset in its owner.
+ */
+class MetaProperty : public NonCopyable
+{
+    friend MetaClass;
+
+    std::string m_name;
+    const std::string* m_typeName;
+    std::ptrdiff_t m_offset;
+    std::size_t m_index;
+    const MetaClass* m_metaClass;
+    mutable std::atomic<MetaProperty*> m_next;
+private:
+    /**
+     * @brief   Constructor.
+     */
+    MetaProperty(const MetaClass* metaClass, const std::string& name, 
+        const std::string* typeName, std::ptrdiff_t offset, std::size_t index);
+public:
+    /**
+     * @brief   Gets the name of the property.
+     * @return  The name.
+     */
+    const std::string& name() const;
+
+    /**
+     * @brief   Gets the type name of the property.
+     * @return  The type name.
+     */
+    const std::string& typeName() const;
+
+    /**
+     * @brief   Gets the index of the property among all properties of an object, including the
+     *          ones of base classes.
+     * @return  The index.
+     */
+    std::size_t index() const;
+
+    /**
+     * @brief   Gets the offset of the property within its owner.
+     * @return  The offset in bytes.
+     */
+    std::ptrdiff_t offset() const;
+
+    /**
+     * @brief   Gets the class declaring the property.
+     * @return  The class.
+     */
+    const MetaClass& metaClass() const;
+
+    /**
+     * @brief   Gets the next property declared by the same class.
+     * @return  The next property or @c nullptr if this is the last one.
+     * @remarks This routine is thread-safe.
+     */
+    const MetaProperty* next() const;
+
+    /**
+     * @brief   Gets the property of an object.
+     * @param   object  The object. Must be an instance of the declaring class.
+     * @return  The property.
+     */
+    PropertyBase* property(ReflectableObject* object) const;
+
+    /**
+     * @overload
+     */
+    const PropertyBase* property(const ReflectableObject* object) const;
+};
+
+// ============================================================================================== //
+// [MetaClass]                                                                                    //
+// ============================================================================================== //
+
+/**
+ * @brief   Class-level reflection data of a class declaring properties.
+ *
+ * There is one meta class per class declaring properties, obtained using @c of. Its properties
+ * are registered by the first instance constructed and are read without locking afterwards, so
+ * properties have to be members of their owner, constructed in the same order for all instances.
+ */
+class MetaClass : public NonCopyable
+{
+    mutable std::mutex m_registrationLock;
+    std::vector<std::unique_ptr<MetaProperty>> m_storage;
+    mutable std::atomic<const internal::PropertyIndex*> m_index;
+    mutable std::vector<std::unique_ptr<internal::PropertyIndex>> m_indexStorage;
+    std::atomic<MetaProperty*> m_firstProperty;
+    std::atomic<std::size_t> m_numOwnProperties;
+    const MetaClass* m_parent;
+    std::size_t m_firstIndex;
+private:
+    MetaClass();
+
+    /**
+     * @brief   Builds the name index of the properties registered so far and publishes it.
+     * @return  The index.
+     */
+    const internal::PropertyIndex& buildIndex() const;
+
+    /**
+     * @brief   Gets the up to date index, building it if required.
+     * @return  The index.
+     */
+    const internal::PropertyIndex& index() const;
+public:
+    /**
+     * @brief   Gets the meta class of a class.
+     * @tparam  ClassT  The class.
+     * @return  The meta class.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename ClassT>
+    static MetaClass& of();
+
+    /**
+     * @brief   Gets the meta class of the nearest base class declaring properties.
+     * @return  The meta class or @c nullptr if no base class declares properties.
+     */
+    const MetaClass* parent() const;
+
+    /**
+     * @brief   Gets the first property declared by this class.
+     * @return  The property or @c nullptr if none has been registered yet.
+     * @remarks This routine is thread-safe.
+     */
+    const MetaProperty* firstProperty() const;
+
+    /**
+     * @brief   Gets the number of properties of instances of this class, including the ones of
+     *          base classes.
+     * @return  The number of properties.
+     * @remarks This routine is thread-safe.
+     */
+    std::size_t numProperties() const;
+
+    /**
+     * @brief   Invokes a function for each property, base class properties first.
+     * @param   func    The function, called with a @c const @c MetaProperty&.
+     */
+    template<typename FuncT>
+    void forEachProperty(FuncT&& func) const;
+
+    /**
+     * @brief   Looks up a property by name, including the ones of base classes.
+     * @param   name    The name of the property.
+     * @return  The property or @c nullptr if there is none of that name. Properties of derived
+     *          classes hide equally named ones of their bases.
+     * @remarks This routine is thread-safe. The index is built by the first lookup, as by then
+     *          at least one instance registered all properties of the class.
+     */
+    const MetaProperty* findProperty(NameRef name) const;
+
+    /**
+     * @brief   Looks up a property by index, including the ones of base classes.
+     * @param   index   The index of the property.
+     * @return  The property or @c nullptr if the index is out of range.
+     * @remarks This routine is thread-safe. See @c findProperty regarding the index.
+     */
+    const MetaProperty* propertyAt(std::size_t index) const;
+
+    /**
+     * @internal
+     * @brief   Gets the descriptor of the next property constructed by an instance, registering
+     *          it if the instance is the first one getting there.
+     * @param   parent      The meta class of the nearest base class declaring properties. Only
+     *                      evaluated for the first property.
+     * @param   previous    The descriptor of the previous property of the instance declared by
+     *                      this class or @c nullptr for the first one.
+     * @param   name        The property name.
+     * @param   typeName    The type name of the property.
+     * @param   offset      The offset of the property in its owner.
+     * @return  The descriptor.
+     * @throws  InvalidUsage if the instance constructs its properties differently from the
+     *                       instance that registered them.
+     * @remarks This routine is thread-safe.
+     */
+    const MetaProperty& nextProperty(const MetaClass* parent, const MetaProperty* previous, 
+        const std::string& name, const std::string* typeName, std::ptrdiff_t offset);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [NameRef]                                                     //
+// ============================================================================================== //
+
+inline NameRef::NameRef(const char* name)
+    : m_data(name)
+    , m_size(std::strlen(name))
+{}
+
+inline NameRef::NameRef(const std::string& name)
+    : m_data(name.data())
+    , m_size(name.size())
+{}
+
+inline constexpr NameRef::NameRef(const char* data, std::size_t size)
+    : m_data(data)
+    , m_size(size)
+{}
+
+inline constexpr const char* NameRef::data() const
+{
+    return m_data;
+}
+
+inline constexpr std::size_t NameRef::size() const
+{
+    return m_size;
+}
+
+inline constexpr uint64_t NameRef::hash() const
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        hash = (hash ^ static_cast<uint8_t>(m_data[i])) * 0x100000001B3;
+    }
+    return hash;
+}
+
+inline bool NameRef::operator == (const std::string& other) const
+{
+    return m_size == other.size() && std::memcmp(m_data, other.data(), m_size) == 0;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [MetaProperty]                                                //
+// ============================================================================================== //
+
+inline MetaProperty::MetaProperty(const MetaClass* metaClass, const std::string& name, 
+        const std::string* typeName, std::ptrdiff_t offset, std::size_t index)
+    : m_name(name)
+    , m_typeName(typeName)
+    , m_offset(offset)
+    , m_index(index)
+    , m_metaClass(metaClass)
+    , m_next(nullptr)
+{}
+
+inline const std::string& MetaProperty::name() const
+{
+    return m_name;
+}
+
+inline const std::string& MetaProperty::typeName() const
+{
+    return *m_typeName;
+}
+
+inline std::size_t MetaProperty::index() const
+{
+    return m_index;
+}
+
+inline std::ptrdiff_t MetaProperty::offset() const
+{
+    return m_offset;
+}
+
+inline const MetaClass& MetaProperty::metaClass() const
+{
+    return *m_metaClass;
+}
+
+inline const MetaProperty* MetaProperty::next() const
+{
+    return m_next.load(std::memory_order_acquire);
+}
+
+inline PropertyBase* MetaProperty::property(ReflectableObject* object) const
+{
+    return reinterpret_cast<PropertyBase*>(reinterpret_cast<char*>(object) + m_offset);
+}
+
+inline const PropertyBase* MetaProperty::property(const ReflectableObject* object) const
+{
+    return reinterpret_cast<const PropertyBase*>(
+        reinterpret_cast<const char*>(object) + m_offset);
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [MetaClass]                                                   //
+// ============================================================================================== //
+
+inline MetaClass::MetaClass()
+    : m_index(nullptr)
+    , m_firstProperty(nullptr)
+    , m_numOwnProperties(0)
+    , m_parent(nullptr)
+    , m_firstIndex(0)
+{}
+
+template<typename ClassT>
+inline MetaClass& MetaClass::of()
+{
+    static MetaClass metaClass;
+    return metaClass;
+}
+
+inline const MetaClass* MetaClass::parent() const
+{
+    // Published along with the first property.
+    return firstProperty() ? m_parent : nullptr;
+}
+
+inline const MetaProperty* MetaClass::firstProperty() const
+{
+    return m_firstProperty.load(std::memory_order_acquire);
+}
+
+inline std::size_t MetaClass::numProperties() const
+{
+    // Loading the count first makes sure the first index is published, too.
+    auto numOwn = m_numOwnProperties.load(std::memory_order_acquire);
+    return numOwn ? m_firstIndex + numOwn : 0;
+}
+
+template<typename FuncT>
+inline void MetaClass::forEachProperty(FuncT&& func) const
+{
+    if (auto base = parent())
+    {
+        base->forEachProperty(func);
+    }
+    for (auto cur = firstProperty(); cur; cur = cur->next())
+    {
+        func(*cur);
+    }
+}
+
+inline const internal::PropertyIndex& MetaClass::index() const
+{
+    auto index = m_index.load(std::memory_order_acquire);
+    if (!index || index->numProperties != numProperties())
+    {
+        index = &buildIndex();
+    }
+    return *index;
+}
+
+inline const MetaProperty* MetaClass::findProperty(NameRef name) const
+{
+    auto index = &this->index();
+
+    auto hash = name.hash();
+    auto mask = index->buckets.size() - 1;
+    for (auto i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask)
+    {
+        const auto& bucket = index->buckets[i];
+        if (!bucket.property)
+        {
+            return nullptr;
+        }
+        if (bucket.hash == hash && name == bucket.property->name())
+        {
+            return bucket.property;
+        }
+    }
+}
+
+inline const MetaProperty* MetaClass::propertyAt(std::size_t index) const
+{
+    const auto& properties = this->index().properties;
+    return index < properties.size() ? properties[index] : nullptr;
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_METACLASS_HPP
@@ -0,0 +1,211 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_MPMCQUEUE_HPP
+#define ZYCORE_MPMCQUEUE_HPP
+
+#include "zycore/Utils.hpp"
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [MpmcQueue]                                                                                    //
+// ============================================================================================== //
+
+/**
+ * @brief   Bounded lock-free multi-producer multi-consumer queue.
+ *          
+ * Dmitry Vyukov's array based design: every cell carries a sequence number telling producers
+ * and consumers whether it is ready for them, so both sides only contend on a single atomic 
+ * position each and never wait for each other unless the queue is full or empty.
+ */
+template<typename T>
+class MpmcQueue : public NonCopyable
+{
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask;
+    // Producers and consumers are kept on separate cache lines.
+    char m_padding0[64];
+    std::atomic<std::size_t> m_enqueuePos;
+    char m_padding1[64];
+    std::atomic<std::size_t> m_dequeuePos;
+    char m_padding2[64];
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   capacity    The maximum number of elements, rounded up to the next power of two.
+     */
+    explicit MpmcQueue(std::size_t capacity);
+
+    /**
+     * @brief   Destructor. Destroys the remaining elements.
+     */
+    ~MpmcQueue();
+public: // Public interface.
+    /**
+     * @brief   Gets the maximum number of elements.
+     * @return  The capacity.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief   Appends an element.
+     * @param   value   The element.
+     * @return  @c true on success, @c false if the queue is full.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename ValueT>
+    bool tryPush(ValueT&& value);
+
+    /**
+     * @brief   Removes the first element.
+     * @param   value   Receives the element.
+     * @return  @c true on success, @c false if the queue is empty.
+     * @remarks This routine is thread-safe.
+     */
+    bool tryPop(T& value);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [MpmcQueue]                                                   //
+// ============================================================================================== //
+
+template<typename T>
+inline MpmcQueue<T>::MpmcQueue(std::size_t capacity)
+    : m_enqueuePos(0)
+    , m_dequeuePos(0)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+    m_cells.reset(new Cell[size]);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+inline MpmcQueue<T>::~MpmcQueue()
+{
+    auto end = m_enqueuePos.load(std::memory_order_relaxed);
+    for (auto pos = m_dequeuePos.load(std::memory_order_relaxed); pos != end; ++pos)
+    {
+        reinterpret_cast<T*>(&m_cells[pos & m_mask].storage)->~T();
+    }
+}
+
+template<typename T>
+inline std::size_t MpmcQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+template<typename ValueT>
+inline bool MpmcQueue<T>::tryPush(ValueT&& value)
+{
+    Cell* cell;
+    auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        auto seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(std::forward<ValueT>(value));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+inline bool MpmcQueue<T>::tryPop(T& value)
+{
+    Cell* cell;
+    auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = &m_cells[pos & m_mask];
+        auto seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0)
+        {
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto element = reinterpret_cast<T*>(&cell->storage);
+    value = std::move(*element);
+    element->~T();
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_MPMCQUEUE_HPP
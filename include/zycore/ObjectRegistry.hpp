@@ -0,0 +1,217 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_OBJECTREGISTRY_HPP
+#define ZYCORE_OBJECTREGISTRY_HPP
+
+#ifdef ZYCORE_HEADER_ONLY
+#   error "This file cannot be used in header-only mode."
+#endif // ZYCORE_HEADER_ONLY
+
+#include "zycore/MetaClass.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [ObjectRegistry]                                                                               //
+// ============================================================================================== //
+
+/**
+ * @brief   Process-wide registry of named reflectable objects, by name and by type.
+ *
+ * The registry is opt-in: once enabled, objects register when they are named using
+ * @c ReflectableObject::setObjectName and unregister on rename and destruction. Objects named
+ * while the registry is disabled are not registered.
+ *
+ * Lookups never take a lock. Entries are kept in hash chains that writers, serialized by a mutex,
+ * modify with atomic pointer updates. Readers announce themselves in one of two epochs on
+ * per-thread counter shards, and writers only free unlinked entries after flipping the epoch and
+ * waiting for the readers of the previous one to finish. Looking an object up does not keep it
+ * alive: making sure it is not destroyed while being used is up to the caller.
+ */
+class ObjectRegistry : public NonCopyable
+{
+    friend ReflectableObject;
+
+    struct Entry
+    {
+        std::string name;
+        uint64_t hash;
+        ReflectableObject* object;
+        const MetaClass* metaClass;
+        std::atomic<Entry*> nextByName;
+        std::atomic<Entry*> nextByType;
+    };
+
+    struct Table
+    {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Entry*>[]> byName;
+        std::unique_ptr<std::atomic<Entry*>[]> byType;
+    };
+
+    struct ReaderShard
+    {
+        std::atomic<std::size_t> count;
+        // Each shard lives on its own cache line.
+        char padding[64 - sizeof(std::atomic<std::size_t>)];
+    };
+
+    static const std::size_t kNumShards = 16;
+
+    /**
+     * @brief   Announces a reader for its lifetime.
+     */
+    class ReadGuard : public NonCopyable
+    {
+        std::atomic<std::size_t>* m_count;
+    public:
+        explicit ReadGuard(const ObjectRegistry& registry);
+        ~ReadGuard();
+    };
+
+    std::atomic<bool> m_enabled;
+    std::mutex m_writeLock;
+    std::atomic<Table*> m_table;
+    std::size_t m_numEntries;
+    mutable std::atomic<std::size_t> m_epoch;
+    mutable ReaderShard m_readers[2][kNumShards];
+private:
+    /**
+     * @brief   Constructor.
+     */
+    ObjectRegistry();
+    /**
+     * @brief   Computes the hash of a meta class.
+     * @param   metaClass   The meta class.
+     * @return  The hash.
+     */
+    static uint64_t hash(const MetaClass* metaClass);
+    /**
+     * @brief   Creates an empty table.
+     * @param   numBuckets  The number of buckets, a power of two.
+     * @return  The table.
+     */
+    static Table* createTable(std::size_t numBuckets);
+    /**
+     * @brief   Links an entry into the chains of a table.
+     * @param   table   The table.
+     * @param   entry   The entry.
+     */
+    static void link(Table& table, Entry* entry);
+    /**
+     * @brief   Waits until all readers that may still see unlinked entries have finished.
+     * @remarks Must be called with the write lock held.
+     */
+    void synchronize();
+    /**
+     * @brief   Registers an object under its current name and meta class.
+     * @param   object  The object.
+     */
+    void add(ReflectableObject& object);
+    /**
+     * @brief   Unregisters an object.
+     * @param   object  The object, still carrying the name it was registered under.
+     */
+    void remove(ReflectableObject& object);
+public:
+    /**
+     * @brief   Gets the registry.
+     * @return  The registry.
+     * @remarks This routine is thread-safe.
+     */
+    static ObjectRegistry& instance();
+    /**
+     * @brief   Enables or disables the registration of objects named from now on.
+     * @param   enabled @c true to enable registration, @c false to disable it.
+     * @remarks This routine is thread-safe.
+     *
+     * Disabling the registry does not unregister objects, they are still removed on rename or
+     * destruction.
+     */
+    void setEnabled(bool enabled);
+    /**
+     * @brief   Determines whether objects are registered when they are named.
+     * @return  @c true if enabled, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isEnabled() const;
+    /**
+     * @brief   Looks up an object by name.
+     * @param   name    The name of the object.
+     * @return  The object or @c nullptr if no registered object has that name. If multiple ones
+     *          do, the one named last.
+     * @remarks This routine is thread-safe.
+     */
+    ReflectableObject* find(NameRef name) const;
+    /**
+     * @brief   Collects the registered objects of a class.
+     * @param   metaClass   The meta class of the objects, as returned by 
+     *                      @c ReflectableObject::metaClass when they were named.
+     * @return  The objects. Objects of derived classes declaring properties of their own are
+     *          not included.
+     * @remarks This routine is thread-safe.
+     */
+    std::vector<ReflectableObject*> objectsOf(const MetaClass& metaClass) const;
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [ObjectRegistry]                                              //
+// ============================================================================================== //
+
+inline ObjectRegistry& ObjectRegistry::instance()
+{
+    // Objects may be destroyed during static destruction, so the registry is never freed.
+    static auto registry = new ObjectRegistry;
+    return *registry;
+}
+
+inline void ObjectRegistry::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+inline bool ObjectRegistry::isEnabled() const
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+inline uint64_t ObjectRegistry::hash(const MetaClass* metaClass)
+{
+    auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(metaClass)) * 0x9E3779B97F4A7C15;
+    return hash ^ (hash >> 32);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_OBJECTREGISTRY_HPP
@@ -96,6 +96,7 @@ protected: // Copy and move semantics (used by OptionalImpl)
             else
             {
                 new (ptr()) T{std::move(*other.ptr())};
+                m_hasValue = true;
             }
 
             other.destroyValue();
@@ -104,8 +105,6 @@ protected: // Copy and move semantics (used by OptionalImpl)
         {
             destroyValue();
         }
-
-        m_hasValue = other.m_hasValue;
     }
 
     template<typename TT = T, std::enable_if_t<IsCopyable<TT>::value, int> = 0>
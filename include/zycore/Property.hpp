@@ -29,12 +29,19 @@
 #endif // ZYCORE_HEADER_ONLY
 
 #include "zycore/ReflectableObject.hpp"
+#include "zycore/BinaryStream.hpp"
+#include "zycore/CharConv.hpp"
 #include "zycore/Exceptions.hpp"
 
 #include <string>
-#include <unordered_map>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
 
 namespace zycore
 {
@@ -45,22 +52,39 @@ namespace zycore
 /**
  * @brief   Abstract base class for properties.
  * Provides raw-data access, type information and value access using strings.
+ *
+ * Properties carry no reflection data themselves: name, type name and position in the owner are
+ * described by a @c MetaProperty shared by all instances of the owner's class.
  */
-class PropertyBase : public ReflectableObject
+class PropertyBase : public NonCopyable
 {
-    std::string m_name;
-    ReflectableObject* m_owner;
-public:
+    const MetaProperty* m_meta;
+protected:
     /**
      * @brief   Constructor.
+     */
+    PropertyBase();
+    /**
+     * @brief   Attaches the property to its descriptor.
+     * @tparam  OwnerT  The class declaring the property.
      * @param   owner   The owner object of this property. May NOT be @c nullptr.
      * @param   name    The name of the property.
+     * @throws  InvalidUsage if the property is no member of @c owner.
+     *
+     * Has to be called by the most derived constructor, as the type name is queried.
      */
-    PropertyBase(ReflectableObject* owner, const std::string& name);
+    template<typename OwnerT>
+    void attach(OwnerT* owner, const std::string& name);
+    /**
+     * @brief   Determines whether the property was attached to its owner.
+     * @return  @c true once @c attach was called, else @c false.
+     */
+    bool isAttached() const;
+public:
     /**
      * @brief   Destructor.
      */
-    virtual ~PropertyBase();
+    virtual ~PropertyBase() = default;
 public:
     /**
      * @brief   Sets the property using a string.
@@ -83,10 +107,45 @@ public:
      */
     virtual std::string toString() const;
     /**
-     * @brief   Gets the name of the property.
-     * @return  The name of the property.
+     * @brief   Sets the property from its string representation, without throwing on invalid
+     *          input or allocating for it.
+     * @param   first   The start of the string.
+     * @param   last    The end of the string.
+     * @return  @c true if the value was set, @c false if the string is invalid or the property
+     *          cannot be set from a string, which the default implementation assumes.
      */
-    virtual const std::string& name() const;
+    virtual bool tryFromChars(const char* first, const char* last);
+    /**
+     * @brief   Determines whether the property implements @c tryFromChars, so a @c false result
+     *          means the string was rejected.
+     * @return  @c true if @c tryFromChars is implemented, else @c false, which the default
+     *          implementation returns.
+     */
+    virtual bool supportsFromChars() const;
+    /**
+     * @brief   Writes the string representation of the property into a buffer.
+     * @param   first   The start of the buffer.
+     * @param   last    The end of the buffer.
+     * @return  The end of the written characters or @c nullptr if the buffer is too small. No
+     *          terminating null character is written.
+     *
+     * The default implementation writes the result of @c toString.
+     */
+    virtual char* toChars(char* first, char* last) const;
+    /**
+     * @brief   Serializes the value of the property, as used for deltas.
+     * @param   stream  The stream to write to.
+     *
+     * The default implementation writes the result of @c toString, prefixed with its length.
+     */
+    virtual void writeValue(OBinaryStream& stream) const;
+    /**
+     * @brief   Sets the property from a value serialized by @c writeValue.
+     * @param   stream  The stream to read from.
+     * @throws  OutOfBounds if the stream ends prematurely.
+     * @throws  InvalidUsage if the value is invalid for the property.
+     */
+    virtual void readValue(IBinaryStream& stream);
     /**
      * @brief   Gets the type of the property.
      * @return  The property type.
@@ -103,6 +162,16 @@ public:
      */
     virtual size_t rawDataLen() const = 0;
 public:
+    /**
+     * @brief   Gets the name of the property.
+     * @return  The name of the property.
+     */
+    const std::string& name() const;
+    /**
+     * @brief   Gets the descriptor of the property.
+     * @return  The descriptor.
+     */
+    const MetaProperty& metaProperty() const;
     /**
      * @brief   Gets the owner of the property.
      * @return  The owner.
@@ -118,14 +187,53 @@ public:
 // Implementation of inline methods [PropertyBase]                                                //
 // ============================================================================================== //
 
+inline PropertyBase::PropertyBase()
+    : m_meta(nullptr)
+{}
+
+template<typename OwnerT>
+inline void PropertyBase::attach(OwnerT* owner, const std::string& name)
+{
+    static_assert(std::is_base_of<ReflectableObject, OwnerT>::value, 
+        "property owners have to derive from ReflectableObject");
+    assert(owner);
+
+    auto self = reinterpret_cast<char*>(this);
+    auto ownerOffset = self - reinterpret_cast<char*>(owner);
+    if (ownerOffset < 0 || static_cast<std::size_t>(ownerOffset) >= sizeof(OwnerT))
+    {
+        throw InvalidUsage("properties have to be members of their owner");
+    }
+
+    ReflectableObject* object = owner;
+    m_meta = &object->attachProperty(MetaClass::of<OwnerT>(), name, &typeName(), 
+        self - reinterpret_cast<char*>(object));
+}
+
+inline bool PropertyBase::isAttached() const
+{
+    return m_meta != nullptr;
+}
+
+inline const std::string& PropertyBase::name() const
+{
+    return m_meta->name();
+}
+
+inline const MetaProperty& PropertyBase::metaProperty() const
+{
+    return *m_meta;
+}
+
 inline const ReflectableObject* PropertyBase::owner() const
 {
-    return m_owner;
+    return reinterpret_cast<const ReflectableObject*>(
+        reinterpret_cast<const char*>(this) - m_meta->offset());
 }
 
 inline ReflectableObject* PropertyBase::owner()
 {
-    return m_owner;
+    return reinterpret_cast<ReflectableObject*>(reinterpret_cast<char*>(this) - m_meta->offset());
 }
 
 // ============================================================================================== //
@@ -139,27 +247,61 @@ public:
     using Setter = std::function<void(const T&)>;
     using Getter = std::function<const T&()>;
 protected:
+    /**
+     * @brief   Custom accessors, only allocated for properties having any.
+     */
+    struct Accessors
+    {
+        Getter getter;
+        Setter setter;
+    };
+
     T& m_value;
-    Setter m_setter;
-    Getter m_getter;
+    std::unique_ptr<Accessors> m_accessors;
 public:
     /**
      * @brief   Constructor.
-     * @param   owner   The owner object of this property. May NOT be @c nullptr.
-     * @param   name    The name of the property.
      * @param   member  The variable to represent with this property.
-     * @param   getter  The getter called to obtain the value. See @c defaultGetter.
-     * @param   setter  The setter called to set the value. See @c defaultSetter.
+     * @param   getter  The getter called to obtain the value. Empty to access @c member
+     *                  directly, see @c defaultGetter.
+     * @param   setter  The setter called to set the value. Empty to assign @c member directly,
+     *                  see @c defaultSetter.
      */
-    PropertyTemplatedBase(ReflectableObject* owner, const std::string& name, T& member, 
-        Getter getter, Setter setter);
+    PropertyTemplatedBase(T& member, Getter getter, Setter setter);
     /**
      * @brief   Destructor.
      */
     ~PropertyTemplatedBase() override = default;
+private:
+    void writeValue(OBinaryStream& stream, std::true_type /*isTriviallyCopyable*/) const;
+    void writeValue(OBinaryStream& stream, std::false_type /*isTriviallyCopyable*/) const;
+    void readValue(IBinaryStream& stream, std::true_type /*isTriviallyCopyable*/);
+    void readValue(IBinaryStream& stream, std::false_type /*isTriviallyCopyable*/);
+protected:
+    /**
+     * @brief   Reads the raw bytes @c writeValue writes for trivially copyable types.
+     * @tparam  RawT    The type to interpret the bytes as, of the same size as @c T.
+     * @param   stream  The stream to read from.
+     * @return  The value read.
+     * @throws  OutOfBounds if the stream ends prematurely.
+     *
+     * Types with invalid representations, like @c bool, read them as an integer to validate.
+     */
+    template<typename RawT>
+    static RawT readRaw(IBinaryStream& stream);
 public:
     const void* rawData() const override { return& m_value;  }
     size_t rawDataLen() const override { return sizeof(T); }
+    /**
+     * @copydoc PropertyBase::writeValue
+     *
+     * Trivially copyable values are written as raw bytes.
+     */
+    void writeValue(OBinaryStream& stream) const override;
+    /**
+     * @copydoc PropertyBase::readValue
+     */
+    void readValue(IBinaryStream& stream) override;
 public:
     // TODO: find a better solution here - for objects without assignment
     //       operator defined this will cause errors.
@@ -177,7 +319,8 @@ public:
     const T& defaultGetter() const;
 public: // Access to the reflected object using the property.
     /**
-     * @brief   Sets a new value for the object reflected by the property.
+     * @brief   Sets a new value for the object reflected by the property and marks the property
+     *          dirty on its owner.
      * @param   newValue    The new value to set.
      */
     void set(const T& newValue);
@@ -200,14 +343,13 @@ class PropertyImplementation
 // ============================================================================================== //
 
 template<typename T>
-inline PropertyTemplatedBase<T>::PropertyTemplatedBase(
-    ReflectableObject* owner, const std::string& name, T& member, Getter getter, Setter setter)
-    : PropertyBase(owner, name)
-    , m_value(member)
-    , m_setter(setter)
-    , m_getter(getter)
+inline PropertyTemplatedBase<T>::PropertyTemplatedBase(T& member, Getter getter, Setter setter)
+    : m_value(member)
 {
-    
+    if (getter || setter)
+    {
+        m_accessors.reset(new Accessors{std::move(getter), std::move(setter)});
+    }
 }
 
 template<typename T>
@@ -217,15 +359,31 @@ inline const T& PropertyTemplatedBase<T>::defaultGetter() const
 }
 
 template<typename T>
-void PropertyTemplatedBase<T>::set(const T& newValue)
+inline void PropertyTemplatedBase<T>::set(const T& newValue)
 {
-    m_setter(newValue);
+    if (m_accessors && m_accessors->setter)
+    {
+        m_accessors->setter(newValue);
+    }
+    else
+    {
+        m_value = newValue;
+    }
+    // Unattached properties only convert values, see ConcurrentProperty.
+    if (isAttached())
+    {
+        owner()->markDirty(metaProperty().index());
+    }
 }
 
 template<typename T>
-const T& PropertyTemplatedBase<T>::get() const
+inline const T& PropertyTemplatedBase<T>::get() const
 {
-    return m_getter();
+    if (m_accessors && m_accessors->getter)
+    {
+        return m_accessors->getter();
+    }
+    return m_value;
 }
 
 template<typename T>
@@ -234,6 +392,58 @@ inline void PropertyTemplatedBase<T>::defaultSetter(const T& newValue)
     m_value = newValue;
 }
 
+template<typename T>
+inline void PropertyTemplatedBase<T>::writeValue(OBinaryStream& stream) const
+{
+    writeValue(stream, std::is_trivially_copyable<T>());
+}
+
+template<typename T>
+inline void PropertyTemplatedBase<T>::readValue(IBinaryStream& stream)
+{
+    readValue(stream, std::is_trivially_copyable<T>());
+}
+
+template<typename T>
+inline void PropertyTemplatedBase<T>::writeValue(OBinaryStream& stream, std::true_type) const
+{
+    const T& value = get();
+    stream.rawWrite(stream.wpos(), sizeof(T), reinterpret_cast<const uint8_t*>(&value));
+    stream.wpos(stream.wpos() + sizeof(T));
+}
+
+template<typename T>
+inline void PropertyTemplatedBase<T>::writeValue(OBinaryStream& stream, std::false_type) const
+{
+    PropertyBase::writeValue(stream);
+}
+
+template<typename T>
+inline void PropertyTemplatedBase<T>::readValue(IBinaryStream& stream, std::true_type)
+{
+    set(readRaw<T>(stream));
+}
+
+template<typename T>
+template<typename RawT>
+inline RawT PropertyTemplatedBase<T>::readRaw(IBinaryStream& stream)
+{
+    static_assert(sizeof(RawT) == sizeof(T) && std::is_trivially_copyable<RawT>::value,
+        "raw values have to be trivially copyable and of the property's size");
+
+    // Trivially copyable types are not necessarily default constructible.
+    typename std::aligned_storage<sizeof(RawT), alignof(RawT)>::type value;
+    stream.rawRead(stream.rpos(), sizeof(RawT), reinterpret_cast<uint8_t*>(&value));
+    stream.rpos(stream.rpos() + sizeof(RawT));
+    return *reinterpret_cast<const RawT*>(&value);
+}
+
+template<typename T>
+inline void PropertyTemplatedBase<T>::readValue(IBinaryStream& stream, std::false_type)
+{
+    PropertyBase::readValue(stream);
+}
+
 // ============================================================================================== //
 // [Property]                                                                                     //
 // ============================================================================================== //
@@ -244,33 +454,46 @@ class Property : public PropertyImplementation<T>
 public:
     /**
      * @brief   Constructor.
+     * @tparam  OwnerT  The class declaring the property.
      * @param   owner   The owner object of this property. May NOT be @c nullptr.
      * @param   name    The name of the property.
      * @param   member  The variable to represent with this property.
+     *
+     * Properties without custom accessors read and write @c member directly and store no
+     * accessor functions at all.
+     *
+     * Properties have to be members of @c owner and constructed in the same order for all
+     * instances of @c OwnerT, see @c MetaClass.
      */
-    Property(ReflectableObject* owner, const std::string& name, T& member);
+    template<typename OwnerT>
+    Property(OwnerT* owner, const std::string& name, T& member);
     /**
      * @brief   Constructor.
+     * @tparam  OwnerT  The class declaring the property.
      * @param   owner   The owner object of this property. May NOT be @c nullptr.
      * @param   name    The name of the property.
      * @param   member  The variable to represent with this property.
      * @param   getter  The getter called to obtain the value. See 
      *                  @c defaultGetter.
      */
-    Property(ReflectableObject* owner, const std::string& name, T& member, 
+    template<typename OwnerT>
+    Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Getter getter);
     /**
      * @brief   Constructor.
+     * @tparam  OwnerT  The class declaring the property.
      * @param   owner   The owner object of this property. May NOT be @c nullptr.
      * @param   name    The name of the property.
      * @param   member  The variable to represent with this property.
      * @param   setter  The setter called to set the value. See 
      *                  @c defaultSetter.
      */
-    Property(ReflectableObject* owner, const std::string& name, T& member, 
+    template<typename OwnerT>
+    Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Setter setter);
     /**
      * @brief   Constructor.
+     * @tparam  OwnerT  The class declaring the property.
      * @param   owner   The owner object of this property. May NOT be @c nullptr.
      * @param   name    The name of the property.
      * @param   member  The variable to represent with this property.
@@ -279,7 +502,8 @@ public:
      * @param   setter  The setter called to set the value. See 
      *                  @c defaultSetter.
      */
-    Property(ReflectableObject* owner, const std::string& name, T& member, 
+    template<typename OwnerT>
+    Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Getter getter, 
         typename PropertyTemplatedBase<T>::Setter setter);
 };
@@ -289,33 +513,274 @@ public:
 // ============================================================================================== //
 
 template<typename T>
-inline Property<T>::Property(ReflectableObject* owner, const std::string& name, T& member)
-    : PropertyImplementation<T>(owner, name, member, 
-        std::bind(&PropertyTemplatedBase<T>::defaultGetter, this), 
-        std::bind(&PropertyTemplatedBase<T>::defaultSetter, this, std::placeholders::_1))
-{}
+template<typename OwnerT>
+inline Property<T>::Property(OwnerT* owner, const std::string& name, T& member)
+    : PropertyImplementation<T>(member, nullptr, nullptr)
+{
+    this->attach(owner, name);
+}
 
 template<typename T>
-inline Property<T>::Property(ReflectableObject* owner, const std::string& name, T& member, 
+template<typename OwnerT>
+inline Property<T>::Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Getter getter)
-    : PropertyImplementation<T>(owner, name, member, getter, 
-        std::bind(&PropertyTemplatedBase<T>::defaultSetter, this, std::placeholders::_1))
-{}
+    : PropertyImplementation<T>(member, std::move(getter), nullptr)
+{
+    this->attach(owner, name);
+}
 
 template<typename T>
-inline Property<T>::Property(ReflectableObject* owner, const std::string& name, T& member, 
+template<typename OwnerT>
+inline Property<T>::Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Setter setter)
-    : PropertyImplementation<T>(owner, name, member, 
-        std::bind(&PropertyTemplatedBase<T>::defaultGetter, this), setter)
-{}
+    : PropertyImplementation<T>(member, nullptr, std::move(setter))
+{
+    this->attach(owner, name);
+}
 
 template<typename T>
-inline Property<T>::Property(ReflectableObject* owner, const std::string& name, T& member, 
+template<typename OwnerT>
+inline Property<T>::Property(OwnerT* owner, const std::string& name, T& member, 
         typename PropertyTemplatedBase<T>::Getter getter, 
         typename PropertyTemplatedBase<T>::Setter setter)
-    : PropertyImplementation<T>(owner, name, member, getter, setter)
+    : PropertyImplementation<T>(member, std::move(getter), std::move(setter))
+{
+    this->attach(owner, name);
+}
+
+// ============================================================================================== //
+// [ConcurrentProperty]                                                                           //
+// ============================================================================================== //
+
+namespace internal
+{
+
+/**
+ * @brief   Determines whether values of type @c T can be accessed with a single lock-free
+ *          atomic instruction.
+ */
+template<typename T>
+struct IsLockFreeAccessible : std::integral_constant<bool,
+#ifdef ZYCORE_GNUC
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) &&
+    sizeof(T) <= sizeof(void*) && alignof(T) >= sizeof(T)
+#else
+    false
+#endif
+    > {};
+
+/**
+ * @brief   Synchronizes concurrent access to a trivially copyable value using a sequence lock.
+ *
+ * Writers make the sequence odd while they are modifying the value, readers retry until they
+ * observed the same even sequence before and after copying it.
+ */
+template<typename T, typename EnableT = void>
+class ConcurrentAccess
+{
+    std::atomic<uint32_t> m_sequence;
+public:
+    ConcurrentAccess() : m_sequence(0) {}
+public:
+    T load(const T& value) const;
+    void store(T& value, const T& newValue);
+};
+
+/**
+ * @brief   Synchronizes concurrent access to values small enough to be accessed atomically.
+ */
+template<typename T>
+class ConcurrentAccess<T, typename std::enable_if<IsLockFreeAccessible<T>::value>::type>
+{
+public:
+    T load(const T& value) const;
+    void store(T& value, const T& newValue);
+};
+
+template<typename T, typename EnableT>
+inline T ConcurrentAccess<T, EnableT>::load(const T& value) const
+{
+    // Trivially copyable types are not necessarily default constructible.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type result;
+    for (;;)
+    {
+        auto sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) == 0)
+        {
+            std::memcpy(&result, &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                return *reinterpret_cast<const T*>(&result);
+            }
+        }
+    }
+}
+
+template<typename T, typename EnableT>
+inline void ConcurrentAccess<T, EnableT>::store(T& value, const T& newValue)
+{
+    // Writers exclude each other by moving the sequence from even to odd.
+    auto sequence = m_sequence.load(std::memory_order_relaxed);
+    do
+    {
+        sequence &= ~static_cast<uint32_t>(1);
+    } while (!m_sequence.compare_exchange_weak(
+        sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&value, &newValue, sizeof(T));
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+#ifdef ZYCORE_GNUC
+
+template<typename T>
+inline T ConcurrentAccess<
+    T, typename std::enable_if<IsLockFreeAccessible<T>::value>::type>::load(const T& value) const
+{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type result;
+    __atomic_load(&value, reinterpret_cast<T*>(&result), __ATOMIC_ACQUIRE);
+    return *reinterpret_cast<const T*>(&result);
+}
+
+template<typename T>
+inline void ConcurrentAccess<
+    T, typename std::enable_if<IsLockFreeAccessible<T>::value>::type>::store(
+    T& value, const T& newValue)
+{
+    __atomic_store(&value, &newValue, __ATOMIC_RELEASE);
+}
+
+#endif // ZYCORE_GNUC
+
+} // namespace internal
+
+/**
+ * @brief   Property of a trivially copyable type that may be read by any number of threads while
+ *          being written.
+ * @tparam  T   The type of the property.
+ *
+ * @c get never blocks and never observes a partially written value. Values small enough are 
+ * accessed atomically, all others are protected by a sequence lock. The string conversions and
+ * serialization work on such a snapshot as well, so any thread may convert or replicate the 
+ * property. Writes have to go through this class or the @c PropertyBase interface, writing the
+ * reflected variable directly, or through a @c PropertyTemplatedBase reference, bypasses the 
+ * synchronization.
+ */
+template<typename T>
+class ConcurrentProperty 
+    : public Property<T>
+    , private internal::ConcurrentAccess<T>
+{
+    static_assert(std::is_trivially_copyable<T>::value, 
+        "concurrent properties require trivially copyable types");
+public:
+    /**
+     * @brief   Constructor.
+     * @tparam  OwnerT  The class declaring the property.
+     * @param   owner   The owner object of this property. May NOT be @c nullptr.
+     * @param   name    The name of the property.
+     * @param   member  The variable to represent with this property.
+     */
+    template<typename OwnerT>
+    ConcurrentProperty(OwnerT* owner, const std::string& name, T& member);
+public: // Access to the reflected object using the property.
+    /**
+     * @brief   Sets a new value and marks the property dirty on its owner.
+     * @param   newValue    The new value to set.
+     * @remarks This routine is thread-safe.
+     */
+    void set(const T& newValue);
+    /**
+     * @brief   Gets a copy of the current value.
+     * @return  The value.
+     * @remarks This routine is thread-safe.
+     */
+    T get() const;
+public: // Implementation of PropertyBase, all of these are thread-safe.
+    void fromString(const std::string& val) override;
+    std::string toString() const override;
+    bool tryFromChars(const char* first, const char* last) override;
+    char* toChars(char* first, char* last) const override;
+    void writeValue(OBinaryStream& stream) const override;
+    void readValue(IBinaryStream& stream) override;
+};
+
+// ============================================================================================== //
+// Implementation of template methods [ConcurrentProperty]                                        //
+// ============================================================================================== //
+
+template<typename T>
+template<typename OwnerT>
+inline ConcurrentProperty<T>::ConcurrentProperty(OwnerT* owner, const std::string& name, 
+        T& member)
+    : Property<T>(owner, name, member)
 {}
 
+template<typename T>
+inline void ConcurrentProperty<T>::set(const T& newValue)
+{
+    this->store(this->m_value, newValue);
+    this->owner()->markDirty(this->metaProperty().index());
+}
+
+template<typename T>
+inline T ConcurrentProperty<T>::get() const
+{
+    return this->load(this->m_value);
+}
+
+// Conversions run on a snapshot, through an unattached property of the same type referring to it.
+
+template<typename T>
+inline void ConcurrentProperty<T>::fromString(const std::string& val)
+{
+    auto value = get();
+    PropertyImplementation<T>(value, nullptr, nullptr).fromString(val);
+    set(value);
+}
+
+template<typename T>
+inline std::string ConcurrentProperty<T>::toString() const
+{
+    auto value = get();
+    return PropertyImplementation<T>(value, nullptr, nullptr).toString();
+}
+
+template<typename T>
+inline bool ConcurrentProperty<T>::tryFromChars(const char* first, const char* last)
+{
+    auto value = get();
+    if (!PropertyImplementation<T>(value, nullptr, nullptr).tryFromChars(first, last))
+    {
+        return false;
+    }
+    set(value);
+    return true;
+}
+
+template<typename T>
+inline char* ConcurrentProperty<T>::toChars(char* first, char* last) const
+{
+    auto value = get();
+    return PropertyImplementation<T>(value, nullptr, nullptr).toChars(first, last);
+}
+
+template<typename T>
+inline void ConcurrentProperty<T>::writeValue(OBinaryStream& stream) const
+{
+    auto value = get();
+    PropertyImplementation<T>(value, nullptr, nullptr).writeValue(stream);
+}
+
+template<typename T>
+inline void ConcurrentProperty<T>::readValue(IBinaryStream& stream)
+{
+    auto value = get();
+    PropertyImplementation<T>(value, nullptr, nullptr).readValue(stream);
+    set(value);
+}
+
 // ============================================================================================== //
 // [Basic property types]                                                                         //
 // ============================================================================================== //
@@ -325,15 +790,14 @@ inline Property<T>::Property(ReflectableObject* owner, const std::string& name,
     class PropertyImplementation<type> : public PropertyTemplatedBase<type>                        \
     {                                                                                              \
     public:                                                                                        \
-        PropertyImplementation(ReflectableObject* owner, const std::string& name,                  \
-                type& member, Getter getter, Setter setter)                                        \
-            : PropertyTemplatedBase<type>(owner, name, member, getter, setter) {}                  \
+        PropertyImplementation(type& member, Getter getter, Setter setter)                         \
+            : PropertyTemplatedBase<type>(member, getter, setter) {}                               \
     public:                                                                                        \
         void fromString(const std::string& val) override                                           \
         {                                                                                          \
             try                                                                                    \
             {                                                                                      \
-                m_setter(converter(val));                                                          \
+                set(converter(val));                                                               \
             } catch (const std::exception&)                                                        \
             {                                                                                      \
                 throw InvalidUsage("invalid value provided");                                      \
@@ -342,7 +806,25 @@ inline Property<T>::Property(ReflectableObject* owner, const std::string& name,
                                                                                                    \
         std::string toString() const override                                                      \
         {                                                                                          \
-            return std::to_string(m_getter());                                                     \
+            return std::to_string(get());                                                          \
+        }                                                                                          \
+                                                                                                   \
+        bool supportsFromChars() const override { return true; }                                   \
+                                                                                                   \
+        bool tryFromChars(const char* first, const char* last) override                            \
+        {                                                                                          \
+            type value;                                                                            \
+            if (!zycore::fromChars(first, last, value))                                            \
+            {                                                                                      \
+                return false;                                                                      \
+            }                                                                                      \
+            set(value);                                                                            \
+            return true;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        char* toChars(char* first, char* last) const override                                      \
+        {                                                                                          \
+            return zycore::toChars(first, last, get());                                            \
         }                                                                                          \
                                                                                                    \
         const std::string& typeName() const override                                               \
@@ -371,18 +853,56 @@ template<>
 class PropertyImplementation<bool> : public PropertyTemplatedBase<bool>
 {
 public:
-    PropertyImplementation(ReflectableObject* owner, const std::string& name, bool& member, 
-        Getter getter, Setter setter) : PropertyTemplatedBase<bool>(owner, name, member, getter,
-        setter) {}
+    PropertyImplementation(bool& member, Getter getter, Setter setter) 
+        : PropertyTemplatedBase<bool>(member, getter, setter) {}
 public:
     void fromString(const std::string& val) override
     {
-        m_setter(!(val == "false" || val == "0"));
+        set(!(val == "false" || val == "0"));
     }
 
     std::string toString() const override
     {
-        return m_getter() ? "true" : "false";
+        return get() ? "true" : "false";
+    }
+
+    bool supportsFromChars() const override
+    {
+        return true;
+    }
+
+    bool tryFromChars(const char* first, const char* last) override
+    {
+        NameRef val(first, static_cast<std::size_t>(last - first));
+        if (val == "true" || val == "1")
+        {
+            set(true);
+        }
+        else if (val == "false" || val == "0")
+        {
+            set(false);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    char* toChars(char* first, char* last) const override
+    {
+        return internal::copyChars(first, last, get() ? "true" : "false");
+    }
+
+    void readValue(IBinaryStream& stream) override
+    {
+        // Any byte but 0 and 1 would be an invalid bool.
+        auto raw = readRaw<uint8_t>(stream);
+        if (raw > 1)
+        {
+            throw InvalidUsage("invalid bool value");
+        }
+        set(raw != 0);
     }
 
     const std::string& typeName() const override
@@ -397,18 +917,38 @@ class PropertyImplementation<std::string>
     : public PropertyTemplatedBase<std::string>
 {
 public:
-    PropertyImplementation(ReflectableObject* owner, const std::string& name, 
-            std::string& member, Getter getter, Setter setter) 
-        : PropertyTemplatedBase<std::string>(owner, name, member, getter, setter) {}
+    PropertyImplementation(std::string& member, Getter getter, Setter setter) 
+        : PropertyTemplatedBase<std::string>(member, getter, setter) {}
 public:
     void fromString(const std::string& val) override
     {
-        m_setter(val);
+        set(val);
     }
 
     std::string toString() const override
     {
-        return m_getter();
+        return get();
+    }
+
+    bool supportsFromChars() const override
+    {
+        return true;
+    }
+
+    bool tryFromChars(const char* first, const char* last) override
+    {
+        set(std::string(first, last));
+        return true;
+    }
+
+    char* toChars(char* first, char* last) const override
+    {
+        const auto& value = get();
+        if (static_cast<std::size_t>(last - first) < value.size())
+        {
+            return nullptr;
+        }
+        return std::copy(value.cbegin(), value.cend(), first);
     }
 
     const std::string& typeName() const override
@@ -424,61 +964,288 @@ public:
 
 namespace internal
 {
-    template<typename T>
-    std::unordered_map<T, std::string> enumValuesToString(const std::string& enumValues)
+    /**
+     * @brief   Counts the comma separated enumerators in a stringized enumerator list.
+     */
+    constexpr bool isEnumSpace(char c)
     {
-        std::istringstream                 ss(enumValues);
-        std::unordered_map<T, std::string> map;
-        std::string                        curItem;
-        std::underlying_type_t<T>          enumVal = 0;
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
 
-        while (std::getline(ss, curItem, ','))
+    constexpr std::size_t countEnumerators(const char* list)
+    {
+        // A trailing comma doesn't start another enumerator.
+        std::size_t count = 1;
+        char last = 0;
+        for (; *list; ++list)
         {
-            curItem.erase(std::remove(curItem.begin(), curItem.end(), ' '));
-            map[static_cast<T>(enumVal++)] = curItem;
+            count += *list == ',';
+            if (!isEnumSpace(*list))
+            {
+                last = *list;
+            }
         }
-        return map;
+        return last == ',' ? count - 1 : count;
     }
 
-    template<typename K, typename V>
-    std::unordered_map<V, K> mapReverseKeyValue(const std::unordered_map<K, V>& in)
+    /**
+     * @brief   Rounds up to a power of two.
+     */
+    constexpr std::size_t enumTablePow2(std::size_t min)
     {
-        std::unordered_map<V, K> out;
-        for (const auto& curPair : in)
+        std::size_t pow2 = 1;
+        while (pow2 < min)
         {
-            out[curPair.second] = curPair.first;
+            pow2 *= 2;
         }
-        return out;
+        return pow2;
     }
 
-}
+    /**
+     * @brief   Finalizer of SplitMix64, used to derive perfect hash slots from name hashes.
+     */
+    constexpr uint64_t mixEnumHash(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief   Static name table of an enum with @c NumT sequential enumerators.
+     *
+     * Built at compile time by @c makeEnumTable. Value to name is an array access, name to value
+     * a single probe into a perfect hash table built by hash and displace: names are spread
+     * over buckets of about two, each bucket has a displacement chosen so that its names land in
+     * slots not used by any other name.
+     */
+    template<std::size_t NumT>
+    struct EnumTable
+    {
+        static const std::size_t kNumSlots = enumTablePow2(NumT * 2);
+        static const std::size_t kNumBuckets = enumTablePow2((NumT + 1) / 2);
+        static const uint16_t kEmpty = 0xFFFF;
+        static_assert(NumT < kEmpty, "too many enumerators");
+
+        struct Name
+        {
+            const char* data = nullptr;
+            std::size_t size = 0;
+        };
+
+        Name names[NumT] = {};
+        uint16_t slots[kNumSlots] = {};
+        uint16_t displacements[kNumBuckets] = {};
+
+        static constexpr std::size_t bucketOf(uint64_t hash)
+        {
+            return static_cast<std::size_t>(mixEnumHash(hash) >> 32) & (kNumBuckets - 1);
+        }
+
+        static constexpr std::size_t slotOf(uint64_t hash, uint16_t displacement)
+        {
+            return static_cast<std::size_t>(
+                mixEnumHash(hash + displacement * 0x9E3779B97F4A7C15)) & (kNumSlots - 1);
+        }
+
+        /**
+         * @brief   Gets the name of a value.
+         * @return  The name, empty if the value is out of range.
+         */
+        NameRef name(std::size_t value) const
+        {
+            return value < NumT ? NameRef(names[value].data, names[value].size) : NameRef("", 0);
+        }
+
+        /**
+         * @brief   Looks up the value of a name.
+         * @return  The value or @c -1 if there is no enumerator of that name.
+         */
+        int find(NameRef name) const
+        {
+            auto hash = name.hash();
+            auto index = slots[slotOf(hash, displacements[bucketOf(hash)])];
+            if (index == kEmpty || names[index].size != name.size()
+                || std::memcmp(names[index].data, name.data(), name.size()) != 0)
+            {
+                return -1;
+            }
+            return index;
+        }
+    };
+
+    /**
+     * @brief   Parses a stringized enumerator list into an @c EnumTable.
+     * @param   list    The list, e.g. @c "Red, Green, Blue". Enumerators are numbered from 0,
+     *                  explicit enumerator values are not supported. A trailing comma is
+     *                  ignored, as by the compiler.
+     */
+    template<std::size_t NumT>
+    constexpr EnumTable<NumT> makeEnumTable(const char* list)
+    {
+        using Table = EnumTable<NumT>;
+        Table table{};
+        uint64_t hashes[NumT] = {};
+        for (std::size_t i = 0; i < NumT; ++i)
+        {
+            while (isEnumSpace(*list))
+            {
+                ++list;
+            }
+            const char* begin = list;
+            while (*list && *list != ',')
+            {
+                if (*list == '=')
+                {
+                    throw "explicit enumerator values are not supported";
+                }
+                ++list;
+            }
+            const char* end = list;
+            while (end != begin && isEnumSpace(end[-1]))
+            {
+                --end;
+            }
+            if (*list)
+            {
+                ++list;
+            }
+            table.names[i].data = begin;
+            table.names[i].size = static_cast<std::size_t>(end - begin);
+            hashes[i] = NameRef(begin, table.names[i].size).hash();
+        }
+
+        // Groups the names by bucket.
+        std::size_t bucketBegin[Table::kNumBuckets + 1] = {};
+        uint16_t byBucket[NumT] = {};
+        for (std::size_t i = 0; i < NumT; ++i)
+        {
+            ++bucketBegin[Table::bucketOf(hashes[i]) + 1];
+        }
+        for (std::size_t b = 0; b < Table::kNumBuckets; ++b)
+        {
+            bucketBegin[b + 1] += bucketBegin[b];
+        }
+        std::size_t bucketFill[Table::kNumBuckets] = {};
+        for (std::size_t i = 0; i < NumT; ++i)
+        {
+            auto bucket = Table::bucketOf(hashes[i]);
+            byBucket[bucketBegin[bucket] + bucketFill[bucket]++] = static_cast<uint16_t>(i);
+        }
+
+        for (std::size_t i = 0; i < Table::kNumSlots; ++i)
+        {
+            table.slots[i] = Table::kEmpty;
+        }
+
+        // Places large buckets first, while the table is still empty.
+        bool placed[Table::kNumBuckets] = {};
+        for (std::size_t n = 0; n < Table::kNumBuckets; ++n)
+        {
+            std::size_t bucket = 0;
+            std::size_t largest = 0;
+            for (std::size_t b = 0; b < Table::kNumBuckets; ++b)
+            {
+                auto size = bucketBegin[b + 1] - bucketBegin[b];
+                if (!placed[b] && size >= largest)
+                {
+                    bucket = b;
+                    largest = size;
+                }
+            }
+            placed[bucket] = true;
+
+            for (uint16_t displacement = 0;; ++displacement)
+            {
+                if (displacement == Table::kEmpty)
+                {
+                    throw "no perfect hash found";
+                }
+                std::size_t numPlaced = 0;
+                for (auto i = bucketBegin[bucket]; i < bucketBegin[bucket + 1]; ++i)
+                {
+                    auto& slot = table.slots[Table::slotOf(hashes[byBucket[i]], displacement)];
+                    if (slot != Table::kEmpty)
+                    {
+                        break;
+                    }
+                    slot = byBucket[i];
+                    ++numPlaced;
+                }
+                if (numPlaced == largest)
+                {
+                    table.displacements[bucket] = displacement;
+                    break;
+                }
+
+                // Takes back the names placed for this displacement.
+                for (auto i = bucketBegin[bucket]; i < bucketBegin[bucket] + numPlaced; ++i)
+                {
+                    table.slots[Table::slotOf(hashes[byBucket[i]], displacement)] = Table::kEmpty;
+                }
+            }
+        }
+        return table;
+    }
+} // namespace internal
 
 #define ZYCORE_DECLARE_EXISTING_ENUM_PROPERTY(enumName, ...)                                       \
     template<>                                                                                     \
     class PropertyImplementation<enumName> : public PropertyTemplatedBase<enumName>                \
     {                                                                                              \
-        const std::unordered_map<enumName, std::string> m_valToNameMap                             \
-            = internal::enumValuesToString<enumName>(#__VA_ARGS__);                                \
-        const std::unordered_map<std::string, enumName> m_nameToValMap                             \
-            = internal::mapReverseKeyValue(m_valToNameMap);                                        \
+        using Table = internal::EnumTable<internal::countEnumerators(#__VA_ARGS__)>;               \
+                                                                                                   \
+        static const Table& table()                                                                \
+        {                                                                                          \
+            static constexpr Table kTable                                                          \
+                = internal::makeEnumTable<internal::countEnumerators(#__VA_ARGS__)>(#__VA_ARGS__); \
+            return kTable;                                                                         \
+        }                                                                                          \
     public:                                                                                        \
-        PropertyImplementation(AMUiObject* owner, const std::string& name, enumName& member,       \
-            Getter getter, Setter setter) : PropertyTemplatedBase<enumName>(owner, name,           \
-            member, getter, setter) {}                                                             \
+        PropertyImplementation(enumName& member, Getter getter, Setter setter)                     \
+            : PropertyTemplatedBase<enumName>(member, getter, setter) {}                           \
     public:                                                                                        \
         void fromString(const std::string& val) override                                           \
         {                                                                                          \
-            auto valIt = m_nameToValMap.find(val);                                                 \
-            if (valIt == m_nameToValMap.end())                                                     \
+            auto value = table().find(val);                                                        \
+            if (value < 0)                                                                         \
                 throw InvalidUsage("invalid enum value");                                          \
-            m_setter(valIt->second);                                                               \
+            set(static_cast<enumName>(value));                                                     \
         }                                                                                          \
                                                                                                    \
         std::string toString() const override                                                      \
         {                                                                                          \
-            auto nameIt = m_valToNameMap.find(m_getter());                                         \
-            assert(nameIt != m_valToNameMap.end());                                                \
-            return nameIt->second;                                                                 \
+            auto name = table().name(static_cast<std::size_t>(get()));                             \
+            assert(name.size());                                                                   \
+            return std::string(name.data(), name.size());                                          \
+        }                                                                                          \
+                                                                                                   \
+        bool supportsFromChars() const override { return true; }                                   \
+                                                                                                   \
+        bool tryFromChars(const char* first, const char* last) override                            \
+        {                                                                                          \
+            auto value = table().find(NameRef(first, static_cast<std::size_t>(last - first)));     \
+            if (value < 0)                                                                         \
+                return false;                                                                      \
+            set(static_cast<enumName>(value));                                                     \
+            return true;                                                                           \
+        }                                                                                          \
+                                                                                                   \
+        char* toChars(char* first, char* last) const override                                      \
+        {                                                                                          \
+            auto name = table().name(static_cast<std::size_t>(get()));                             \
+            assert(name.size());                                                                   \
+            if (static_cast<std::size_t>(last - first) < name.size())                              \
+                return nullptr;                                                                    \
+            return std::copy(name.data(), name.data() + name.size(), first);                       \
+        }                                                                                          \
+                                                                                                   \
+        void readValue(IBinaryStream& stream) override                                             \
+        {                                                                                          \
+            auto raw = readRaw<std::underlying_type_t<enumName>>(stream);                          \
+            if (!table().name(static_cast<std::size_t>(raw)).size())                               \
+                throw InvalidUsage("invalid enum value");                                          \
+            set(static_cast<enumName>(raw));                                                       \
         }                                                                                          \
                                                                                                    \
         const std::string& typeName() const override                                               \
@@ -29,14 +29,17 @@
 #endif // ZYCORE_HEADER_ONLY
 
 #include "zycore/SignalObject.hpp"
+#include "zycore/MetaClass.hpp"
 #include "zycore/Optional.hpp"
 
-#include <mutex>
+#include <atomic>
+#include <cassert>
 
 namespace zycore
 {
 
-class PropertyBase;
+class IBinaryStream;
+class OBinaryStream;
 
 // ============================================================================================== //
 // [ReflectableObject]                                                                            //
@@ -45,18 +48,32 @@ class PropertyBase;
 class ReflectableObject : public SignalObject
 {
     std::unique_ptr<std::string> m_objectName;
-    std::vector<PropertyBase*> m_propertyList;
-    mutable std::recursive_mutex m_propertyListLock;
+    const MetaClass* m_metaClass = nullptr;
+    const MetaProperty* m_lastProperty = nullptr;
+    std::atomic<uint64_t> m_dirty{0};
+    std::unique_ptr<std::atomic<uint64_t>[]> m_moreDirty;
+    bool m_isRegistered = false;
+private:
+    /**
+     * @brief   Gets the word of the dirty bitset holding the bit of a property.
+     * @param   index   The property index.
+     * @return  The word.
+     */
+    std::atomic<uint64_t>& dirtyWord(std::size_t index);
+    /**
+     * @overload
+     */
+    const std::atomic<uint64_t>& dirtyWord(std::size_t index) const;
 public: // Public interface.
     /**
      * @brief   Constructor.
      */
     ReflectableObject() = default;
     /**
-     * @brief   Destructor.
+     * @brief   Destructor. Removes the object from the @c ObjectRegistry if it is registered.
      * @remarks This routine is thread-safe.
      */
-    virtual ~ReflectableObject() = default;
+    virtual ~ReflectableObject();
     /**
      * @brief   Gets the object name.
      * @return  The object name if one is set.
@@ -65,48 +82,186 @@ public: // Public interface.
     /**
      * @brief   Sets the object name.
      * @param   name The new object name. May not be empty.
+     *
+     * Registers the object under the new name with the @c ObjectRegistry if it is enabled.
      */
     void setObjectName(const std::string& name);
 public: // Reflection.
+    /**
+     * @brief   Gets the meta class of the most derived class of this object declaring properties.
+     * @return  The meta class or @c nullptr if the object has no properties.
+     */
+    const MetaClass* metaClass() const;
+    /**
+     * @brief   Gets the number of properties of this object.
+     * @return  The number of properties.
+     */
+    std::size_t numProperties() const;
     /**
      * @brief   Obtains the list of properties of this object.
-     * @return  The desired list.
+     * @return  The properties, the ones declared by base classes first.
      * @remarks This routine is thread-safe.
      */
-    std::vector<PropertyBase*>& properties();
+    std::vector<PropertyBase*> properties();
     /**
      * @overload
      */
-    const std::vector<PropertyBase*>& properties() const;
-private: // Internal interface.
-    friend PropertyBase;
+    std::vector<const PropertyBase*> properties() const;
+    /**
+     * @brief   Looks up a property of this object by name.
+     * @param   name    The name of the property.
+     * @return  The property or @c nullptr if the object has no property of that name.
+     * @remarks This routine is thread-safe.
+     */
+    PropertyBase* findProperty(NameRef name);
+    /**
+     * @overload
+     */
+    const PropertyBase* findProperty(NameRef name) const;
+public: // Dirty tracking and replication.
+    /**
+     * @brief   Marks a property as changed. Called by @c PropertyTemplatedBase::set.
+     * @param   index   The index of the property.
+     * @remarks This routine is thread-safe.
+     */
+    void markDirty(std::size_t index);
+    /**
+     * @brief   Determines whether a property changed since the bit was last cleared.
+     * @param   index   The index of the property.
+     * @return  @c true if the property is dirty, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isDirty(std::size_t index) const;
+    /**
+     * @brief   Determines whether any property is dirty.
+     * @return  @c true if a property is dirty, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isDirty() const;
+    /**
+     * @brief   Clears the dirty bits of all properties.
+     * @remarks This routine is thread-safe.
+     */
+    void clearDirty();
+    /**
+     * @brief   Serializes the dirty properties into a delta and clears their dirty bits.
+     * @param   stream  The stream to write the delta to.
+     * @return  The number of properties written.
+     *
+     * Properties changed while the delta is written are either part of it or stay dirty.
+     * Deltas identify properties by index, so they can only be applied to instances of the
+     * same class built from the same declarations.
+     */
+    std::size_t writeDelta(OBinaryStream& stream);
+    /**
+     * @brief   Serializes all properties in the delta format, e.g. for the initial transfer to
+     *          a replica. Dirty bits are left untouched.
+     * @param   stream  The stream to write the snapshot to.
+     * @return  The number of properties written.
+     */
+    std::size_t writeSnapshot(OBinaryStream& stream) const;
     /**
-     * @brief   Registers a given property to this object.
-     * @param   prop    The property to register.
+     * @brief   Applies a delta or snapshot by setting the properties contained.
+     * @param   stream  The stream to read the delta from.
+     * @return  The number of properties set.
+     * @throws  OutOfBounds if the delta is truncated or refers to properties this object does
+     *                      not have.
+     * @throws  InvalidUsage if a value is invalid for its property, e.g. an enum value without
+     *                       enumerator.
+     *
+     * Setting the properties marks them dirty on this object, too, so deltas can be relayed.
      */
-    void registerProperty(PropertyBase *prop);
+    std::size_t applyDelta(IBinaryStream& stream);
+private: // Internal interface.
+    friend PropertyBase;
     /**
-     * @brief   Unregisters a given property from this object.
-     * @param   prop    The property to unregister.
+     * @brief   Attaches a property under construction to its descriptor.
+     * @param   metaClass   The meta class of the class declaring the property.
+     * @param   name        The name of the property.
+     * @param   typeName    The type name of the property.
+     * @param   offset      The offset of the property in this object.
+     * @return  The descriptor of the property.
      */
-    void unregisterProperty(PropertyBase *prop);
+    const MetaProperty& attachProperty(MetaClass& metaClass, const std::string& name, 
+        const std::string* typeName, std::ptrdiff_t offset);
 };
 
 // ============================================================================================== //
 // Implementation of inline methods [ReflectableObject]                                           //
 // ============================================================================================== //
 
-inline std::vector<PropertyBase*>& ReflectableObject::properties()
+inline const MetaClass* ReflectableObject::metaClass() const
+{
+    return m_metaClass;
+}
+
+inline std::size_t ReflectableObject::numProperties() const
+{
+    return m_metaClass ? m_metaClass->numProperties() : 0;
+}
+
+inline std::atomic<uint64_t>& ReflectableObject::dirtyWord(std::size_t index)
+{
+    return index < 64 ? m_dirty : m_moreDirty[index / 64 - 1];
+}
+
+inline const std::atomic<uint64_t>& ReflectableObject::dirtyWord(std::size_t index) const
+{
+    return index < 64 ? m_dirty : m_moreDirty[index / 64 - 1];
+}
+
+inline void ReflectableObject::markDirty(std::size_t index)
+{
+    assert(index < numProperties());
+    dirtyWord(index).fetch_or(uint64_t(1) << (index % 64), std::memory_order_release);
+}
+
+inline bool ReflectableObject::isDirty(std::size_t index) const
+{
+    assert(index < numProperties());
+    return (dirtyWord(index).load(std::memory_order_acquire) >> (index % 64)) & 1;
+}
+
+inline std::vector<PropertyBase*> ReflectableObject::properties()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_propertyListLock);
-    return m_propertyList;
+    std::vector<PropertyBase*> properties;
+    if (m_metaClass)
+    {
+        properties.reserve(m_metaClass->numProperties());
+        m_metaClass->forEachProperty([&](const MetaProperty& property)
+        {
+            properties.push_back(property.property(this));
+        });
+    }
+    return properties;
 }
 
-inline const std::vector<PropertyBase*>& ReflectableObject::properties() const
+inline std::vector<const PropertyBase*> ReflectableObject::properties() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_propertyListLock);
-    return m_propertyList;
+    std::vector<const PropertyBase*> properties;
+    if (m_metaClass)
+    {
+        properties.reserve(m_metaClass->numProperties());
+        m_metaClass->forEachProperty([&](const MetaProperty& property)
+        {
+            properties.push_back(property.property(this));
+        });
+    }
+    return properties;
 }
+
+inline PropertyBase* ReflectableObject::findProperty(NameRef name)
+{
+    auto property = m_metaClass ? m_metaClass->findProperty(name) : nullptr;
+    return property ? property->property(this) : nullptr;
+}
+
+inline const PropertyBase* ReflectableObject::findProperty(NameRef name) const
+{
+    auto property = m_metaClass ? m_metaClass->findProperty(name) : nullptr;
+    return property ? property->property(this) : nullptr;
+}
+
 // ============================================================================================== //
 
 } // namespace zycore
@@ -0,0 +1,520 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ZYCORE_RESULTSIGNAL_HPP
+#define ZYCORE_RESULTSIGNAL_HPP
+
+#include "zycore/Signal.hpp"
+#include "zycore/Optional.hpp"
+
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+namespace zycore
+{
+
+namespace internal
+{
+    template<typename FuncT, typename ResultT, typename ArgsTupleT, typename=void>
+    struct IsResultSlotImpl : std::false_type {};
+
+    template<typename FuncT, typename ResultT, typename... ArgsT>
+    struct IsResultSlotImpl<FuncT, ResultT, std::tuple<ArgsT...>, 
+            decltype(void(std::declval<std::decay_t<FuncT>&>()(std::declval<SlotArg<ArgsT>>()...)))>
+        : std::is_convertible<
+            decltype(std::declval<std::decay_t<FuncT>&>()(std::declval<SlotArg<ArgsT>>()...)), 
+            ResultT> {};
+
+    /**
+     * @brief   Determines whether @c FuncT can be connected to a signal whose slots take 
+     *          @c ArgsT and return @c ResultT.
+     */
+    template<typename FuncT, typename ResultT, typename... ArgsT>
+    using IsResultSlot = IsResultSlotImpl<FuncT, ResultT, std::tuple<ArgsT...>>;
+} // namespace internal
+
+// ============================================================================================== //
+// [combiners]                                                                                    //
+// ============================================================================================== //
+
+/**
+ * @brief   Combiners reducing the return values of the slots of a @c ResultSignal.
+ *          
+ * A combiner is default constructed for every emission and has to provide:
+ * - @c SlotResult, the type the slots return,
+ * - @c Result, the type the emission returns,
+ * - <tt>bool add(SlotResult&& value)</tt>, called with the return value of every slot in 
+ *   connection order. Returning @c false stops the emission, the remaining slots are not called.
+ * - <tt>Result result()</tt>, called once after the last slot.
+ */
+namespace combiners
+{
+
+/**
+ * @brief   Returns the first non-empty result, skipping all slots after it.
+ * @tparam  T   The value type.
+ */
+template<typename T>
+class FirstNonEmpty
+{
+public:
+    using SlotResult = Optional<T>;
+    using Result = Optional<T>;
+private:
+    Result m_result;
+public:
+    bool add(SlotResult&& value);
+    Result result();
+};
+
+/**
+ * @brief   Returns whether all slots returned @c true, stopping at the first @c false.
+ *          
+ * An emission without slots returns @c true.
+ */
+class AllTrue
+{
+public:
+    using SlotResult = bool;
+    using Result = bool;
+private:
+    bool m_result = true;
+public:
+    bool add(SlotResult&& value);
+    Result result();
+};
+
+/**
+ * @brief   Returns the largest result, empty if no slot is connected.
+ * @tparam  T   The value type. Has to be less-than comparable.
+ */
+template<typename T>
+class Maximum
+{
+public:
+    using SlotResult = T;
+    using Result = Optional<T>;
+private:
+    Result m_result;
+public:
+    bool add(SlotResult&& value);
+    Result result();
+};
+
+/**
+ * @brief   Returns the results of all slots in connection order.
+ * @tparam  T   The value type.
+ */
+template<typename T>
+class CollectVector
+{
+public:
+    using SlotResult = T;
+    using Result = std::vector<T>;
+private:
+    Result m_result;
+public:
+    bool add(SlotResult&& value);
+    Result result();
+};
+
+} // namespace combiners
+
+// ============================================================================================== //
+// [ResultConnectionBase]                                                                         //
+// ============================================================================================== //
+
+/**
+ * @brief   Abstract base class for connections to a @c ResultSignal.
+ * @tparam  ResultT The slot's return type.
+ * @tparam  ArgsT   The slot's argument types.
+ */
+template<typename ResultT, typename... ArgsT>
+class ResultConnectionBase : public internal::ConnectionNode
+{
+    template<typename, typename...>
+    friend class ResultSignal;
+private:
+#ifdef ZYCORE_SIGNAL_STATS
+    SignalStats::SlotHistogramPtr m_latency;
+#endif
+public:
+    ResultConnectionBase();
+
+    /**
+     * @brief   Calls the connected slot.
+     * @param   args    The arguments.
+     * @return  The slot's return value.
+     */
+    virtual ResultT call(internal::SlotArg<ArgsT>... args) const = 0;
+
+    /**
+     * @brief   Gets the object the connection's lifetime is bound to.
+     * @return  The object or @c nullptr if the connection is not bound to one.
+     */
+    virtual internal::SignalObjectBase* lifetimeObject() const = 0;
+
+    /**
+     * @brief   Calls the slot, recording the call's latency when signals are instrumented.
+     * @param   args    The arguments.
+     * @return  The slot's return value.
+     */
+    ResultT dispatch(internal::SlotArg<ArgsT>... args) const;
+};
+
+// ============================================================================================== //
+// [ResultConnection]                                                                             //
+// ============================================================================================== //
+
+/**
+ * @brief   Connection between a callable of arbitrary type and a @c ResultSignal.
+ * @tparam  FuncT   The type of the callable.
+ * @tparam  ResultT The slot's return type.
+ * @tparam  ArgsT   The slot's argument types.
+ */
+template<typename FuncT, typename ResultT, typename... ArgsT>
+class ResultConnection
+    : public ResultConnectionBase<ResultT, ArgsT...>
+{
+    FuncT m_func;
+    internal::SignalObjectBase* m_lifetimeObject;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   func    The slot to be connected.
+     * @param   obj     The object whose lifetime to bind to, @c nullptr for none.
+     */
+    explicit ResultConnection(FuncT func, internal::SignalObjectBase* obj = nullptr);
+public: // Implementation of public interface.
+    ResultT call(internal::SlotArg<ArgsT>... args) const override;
+    internal::SignalObjectBase* lifetimeObject() const override;
+};
+
+// ============================================================================================== //
+// [ResultSignal]                                                                                 //
+// ============================================================================================== //
+
+/**
+ * @brief   Signal whose slots return values, reduced by a combiner.
+ * @tparam  CombinerT   The combiner, see @c combiners. Its @c SlotResult is the slots' return 
+ *                      type, its @c Result the emission's.
+ * @tparam  ArgsT       The slot's argument types.
+ *                      
+ * Slots are called directly and in connection order. The combiner may stop the emission at any
+ * slot, e.g. @c combiners::FirstNonEmpty skips all slots after the first one producing a result,
+ * which makes the signal suitable for chains of handlers where an early one usually decides.
+ * 
+ * Connections are managed just like the ones of @c Signal: slots may be bound to the lifetime
+ * of a @c SignalObject and may disconnect themselves while the signal is being emitted.
+ */
+template<typename CombinerT, typename... ArgsT>
+class ResultSignal
+    : public internal::SignalBase
+{
+public:
+    using SlotResult = typename CombinerT::SlotResult;
+    using Result = typename CombinerT::Result;
+private:
+    using Connection = ResultConnectionBase<SlotResult, ArgsT...>;
+public: // Public interface.
+    /**
+     * @brief   Connects a static slot to the signal.
+     * @param   func    The function/lambda to connect. Has to return something convertible
+     *                  to @c SlotResult.
+     * @return  The slot handle.
+     */
+    template<typename FuncT, std::enable_if_t<
+        internal::IsResultSlot<FuncT, typename CombinerT::SlotResult, ArgsT...>::value, int> = 0>
+    SlotHandle connect(FuncT&& func);
+
+    /**
+     * @brief   Connects a slot to the signal binding the connection lifetime to an object.
+     * @param   lifetimeGiver   The object to bind the connection to.
+     * @param   func            The function/lambda to connect.
+     * @return  The slot handle.
+     */
+    template<typename FuncT, std::enable_if_t<
+        internal::IsResultSlot<FuncT, typename CombinerT::SlotResult, ArgsT...>::value, int> = 0>
+    SlotHandle connect(SignalObject* lifetimeGiver, FuncT&& func);
+
+    /**
+     * @brief   Connects a member-function slot to the signal.
+     * @param   object  The object to be connected.
+     * @param   member  The member function.
+     * @return  The slot handle.
+     */
+    template<typename ObjectT, typename MemberResultT, typename... MemberArgsT>
+    SlotHandle connect(ObjectT* object, MemberResultT(ObjectT::*member)(MemberArgsT...));
+
+    /**
+     * @brief   Disconnects an existing connection by its handle.
+     * @param   handle  The connection handle.
+     * @return  @c true on success, @c false if the connection didn't exist.
+     */
+    bool disconnect(SlotHandle handle);
+
+    /**
+     * @brief   Gets the number of connected slots.
+     * @return  The number of slots.
+     * @remarks This routine is thread-safe.
+     */
+    std::size_t numSlots() const;
+
+    /**
+     * @brief   Emits the signal.
+     * @param   args    Arguments to be passed to the slots.
+     * @return  The combined result.
+     */
+    Result emit(internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Shorthand for @c emit.
+     */
+    Result operator () (internal::SlotArg<ArgsT>... args) const;
+
+#ifdef ZYCORE_SIGNAL_STATS
+    /**
+     * @brief   Gets the instrumentation state of this signal.
+     * @return  The statistics.
+     */
+    SignalStats& stats();
+#endif
+private:
+    SlotHandle addSlot(Connection* connection);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [combiners]                                                   //
+// ============================================================================================== //
+
+namespace combiners
+{
+
+template<typename T>
+inline bool FirstNonEmpty<T>::add(SlotResult&& value)
+{
+    if (!value)
+    {
+        return true;
+    }
+
+    m_result = std::move(value);
+    return false;
+}
+
+template<typename T>
+inline typename FirstNonEmpty<T>::Result FirstNonEmpty<T>::result()
+{
+    return std::move(m_result);
+}
+
+inline bool AllTrue::add(SlotResult&& value)
+{
+    m_result = value;
+    return value;
+}
+
+inline AllTrue::Result AllTrue::result()
+{
+    return m_result;
+}
+
+template<typename T>
+inline bool Maximum<T>::add(SlotResult&& value)
+{
+    if (!m_result || m_result.value() < value)
+    {
+        m_result = std::move(value);
+    }
+    return true;
+}
+
+template<typename T>
+inline typename Maximum<T>::Result Maximum<T>::result()
+{
+    return std::move(m_result);
+}
+
+template<typename T>
+inline bool CollectVector<T>::add(SlotResult&& value)
+{
+    m_result.push_back(std::move(value));
+    return true;
+}
+
+template<typename T>
+inline typename CollectVector<T>::Result CollectVector<T>::result()
+{
+    return std::move(m_result);
+}
+
+} // namespace combiners
+
+// ============================================================================================== //
+// Implementation of inline methods [ResultConnectionBase]                                        //
+// ============================================================================================== //
+
+template<typename ResultT, typename... ArgsT>
+inline ResultConnectionBase<ResultT, ArgsT...>::ResultConnectionBase()
+    : internal::ConnectionNode(ConnectionType::kDirect)
+{}
+
+template<typename ResultT, typename... ArgsT>
+inline ResultT ResultConnectionBase<ResultT, ArgsT...>::dispatch(
+    internal::SlotArg<ArgsT>... args) const
+{
+#ifdef ZYCORE_SIGNAL_STATS
+    internal::ScopedSlotTimer timer(m_latency.get());
+#endif
+    return call(args...);
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [ResultConnection]                                            //
+// ============================================================================================== //
+
+template<typename FuncT, typename ResultT, typename... ArgsT>
+inline ResultConnection<FuncT, ResultT, ArgsT...>::ResultConnection(FuncT func, 
+        internal::SignalObjectBase* obj)
+    : m_func(std::move(func))
+    , m_lifetimeObject(obj)
+{}
+
+template<typename FuncT, typename ResultT, typename... ArgsT>
+inline ResultT ResultConnection<FuncT, ResultT, ArgsT...>::call(
+    internal::SlotArg<ArgsT>... args) const
+{
+    return m_func(args...);
+}
+
+template<typename FuncT, typename ResultT, typename... ArgsT>
+inline internal::SignalObjectBase* 
+    ResultConnection<FuncT, ResultT, ArgsT...>::lifetimeObject() const
+{
+    return m_lifetimeObject;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [ResultSignal]                                                //
+// ============================================================================================== //
+
+template<typename CombinerT, typename... ArgsT>
+template<typename FuncT, std::enable_if_t<
+    internal::IsResultSlot<FuncT, typename CombinerT::SlotResult, ArgsT...>::value, int>>
+inline SlotHandle ResultSignal<CombinerT, ArgsT...>::connect(FuncT&& func)
+{
+    auto connection = new ResultConnection<std::decay_t<FuncT>, SlotResult, ArgsT...>(
+        std::forward<FuncT>(func));
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return addSlot(connection);
+}
+
+template<typename CombinerT, typename... ArgsT>
+template<typename FuncT, std::enable_if_t<
+    internal::IsResultSlot<FuncT, typename CombinerT::SlotResult, ArgsT...>::value, int>>
+inline SlotHandle ResultSignal<CombinerT, ArgsT...>::connect(SignalObject* lifetimeGiver, 
+    FuncT&& func)
+{
+    auto connection = new ResultConnection<std::decay_t<FuncT>, SlotResult, ArgsT...>(
+        std::forward<FuncT>(func), lifetimeGiver);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return addSlot(connection);
+}
+
+template<typename CombinerT, typename... ArgsT>
+template<typename ObjectT, typename MemberResultT, typename... MemberArgsT>
+inline SlotHandle ResultSignal<CombinerT, ArgsT...>::connect(ObjectT* object, 
+    MemberResultT(ObjectT::*member)(MemberArgsT...))
+{
+    static_assert(std::is_base_of<SignalObject, ObjectT>::value,
+        "type has to be derived from SignalObject");
+    static_assert(sizeof...(MemberArgsT) == sizeof...(ArgsT),
+        "member-function has to take as many arguments as the signal provides");
+    return connect(object, 
+        internal::MemberFuncBinding<ObjectT, MemberResultT(MemberArgsT...)>(object, member));
+}
+
+template<typename CombinerT, typename... ArgsT>
+inline bool ResultSignal<CombinerT, ArgsT...>::disconnect(SlotHandle handle)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return unlink(handle);
+}
+
+template<typename CombinerT, typename... ArgsT>
+inline std::size_t ResultSignal<CombinerT, ArgsT...>::numSlots() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_numSlots;
+}
+
+template<typename CombinerT, typename... ArgsT>
+inline typename ResultSignal<CombinerT, ArgsT...>::Result 
+    ResultSignal<CombinerT, ArgsT...>::emit(internal::SlotArg<ArgsT>... args) const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    EmitScope scope(*this);
+#ifdef ZYCORE_SIGNAL_STATS
+    m_stats.onEmit();
+#endif
+    CombinerT combiner;
+    for (auto node = firstSlot(); node; node = nextSlot(node))
+    {
+        if (!combiner.add(static_cast<Connection*>(node)->dispatch(args...)))
+        {
+            break;
+        }
+    }
+    return combiner.result();
+}
+
+template<typename CombinerT, typename... ArgsT>
+inline typename ResultSignal<CombinerT, ArgsT...>::Result 
+    ResultSignal<CombinerT, ArgsT...>::operator () (internal::SlotArg<ArgsT>... args) const
+{
+    return emit(args...);
+}
+
+#ifdef ZYCORE_SIGNAL_STATS
+template<typename CombinerT, typename... ArgsT>
+inline SignalStats& ResultSignal<CombinerT, ArgsT...>::stats()
+{
+    return m_stats;
+}
+#endif
+
+template<typename CombinerT, typename... ArgsT>
+inline SlotHandle ResultSignal<CombinerT, ArgsT...>::addSlot(Connection* connection)
+{
+    auto handle = link(connection, connection->lifetimeObject());
+#ifdef ZYCORE_SIGNAL_STATS
+    connection->m_latency = m_stats.onConnect(handle, connection->lifetimeObject());
+#endif
+    return handle;
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_RESULTSIGNAL_HPP
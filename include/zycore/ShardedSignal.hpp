@@ -0,0 +1,303 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_SHARDEDSIGNAL_HPP
+#define ZYCORE_SHARDEDSIGNAL_HPP
+
+#include "zycore/Signal.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [ShardedSignal]                                                                                //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Gets a small per-thread number, assigned round-robin on first use.
+     * @return  The ordinal of the calling thread.
+     */
+    inline std::size_t threadOrdinal()
+    {
+        static std::atomic<std::size_t> counter(0);
+        static thread_local std::size_t ordinal = counter.fetch_add(1, std::memory_order_relaxed);
+        return ordinal;
+    }
+} // namespace internal
+
+/**
+ * @brief   Signal partitioning its slots across independently locked shards.
+ * 
+ * Meant for signals many threads connect to and disconnect from at high rates. Every thread 
+ * connects to a shard of its own (threads are assigned round-robin), so connecting only contends
+ * with threads sharing that shard. Disconnecting touches only the shard the connection lives in,
+ * which is encoded in the upper bits of the slot handle. Emissions walk all shards in turn.
+ * 
+ * Slots in different shards are called in shard order, not in connection order.
+ */
+template<typename... ArgsT>
+class ShardedSignal : public NonCopyable
+{
+    /**
+     * @brief   A shard, padded so neighbouring shards' locks don't share a cache line.
+     */
+    struct Shard
+    {
+        Signal<ArgsT...> signal;
+        char padding[64];
+    };
+
+    static const std::size_t kMaxShards = std::size_t(1) << (sizeof(SlotHandle) * 8 - 
+        kSlotHandleBits);
+
+    std::size_t m_numShards;
+    std::unique_ptr<Shard[]> m_shards;
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   numShards   The number of shards, @c 0 picks the number of hardware threads. 
+     *                      Rounded up to the next power of two.
+     */
+    explicit ShardedSignal(std::size_t numShards = 0);
+public: // Public interface.
+    /**
+     * @brief   Gets the number of shards.
+     * @return  The number of shards.
+     */
+    std::size_t numShards() const;
+
+    /**
+     * @brief   Connects a static slot to the calling thread's shard.
+     * @param   func    The function/lambda to connect.
+     * @return  The slot handle.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    SlotHandle connect(FuncT&& func);
+
+    /**
+     * @brief   Connects a slot to the calling thread's shard, binding the connection lifetime 
+     *          to a signal object.
+     * @param   lifetimeGiver   The object to bind the connection to.
+     * @param   func            The function/lambda to connect.
+     * @param   type            The connection type.
+     * @return  The slot handle.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    SlotHandle connect(SignalObject* lifetimeGiver, FuncT&& func, 
+        ConnectionType type = ConnectionType::kAuto);
+
+    /**
+     * @brief   Connects a member-function slot to the calling thread's shard.
+     * @param   object  The object to be connected.
+     * @param   member  The member function.
+     * @param   type    The connection type.
+     * @return  The slot handle.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename ObjectT, typename... MemberArgsT>
+    SlotHandle connect(ObjectT* object, void(ObjectT::*member)(MemberArgsT...), 
+        ConnectionType type = ConnectionType::kAuto);
+
+    /**
+     * @brief   Disconnects an existing connection by its handle.
+     * @param   handle  The connection handle.
+     * @return  @c true on success, @c false if the connection didn't exist.
+     * @remarks This routine is thread-safe.
+     */
+    bool disconnect(SlotHandle handle);
+
+    /**
+     * @brief   Makes a connection disconnect automatically.
+     * @param   handle  The connection handle.
+     * @return  The scoped connection, empty if @c handle does not refer to a connection.
+     * @remarks This routine is thread-safe.
+     */
+    ScopedConnection makeScoped(SlotHandle handle);
+
+    /**
+     * @brief   Gets the number of connected slots in all shards.
+     * @return  The number of slots.
+     * @remarks This routine is thread-safe, but the shards are counted one after another.
+     */
+    std::size_t numSlots() const;
+
+    /**
+     * @brief   Emits the signal to the slots of all shards.
+     * @param   args    Arguments to be passed to the slots.
+     * @remarks This routine is thread-safe.
+     */
+    void emit(internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Shorthand for @c emit.
+     */
+    void operator () (internal::SlotArg<ArgsT>... args) const;
+private:
+    /**
+     * @brief   Gets the index of the calling thread's shard.
+     */
+    std::size_t localShard() const;
+
+    /**
+     * @brief   Gets the shard a handle belongs to.
+     * @param   handle  The sharded slot handle.
+     * @return  The shard or @c nullptr if the handle is invalid.
+     */
+    Shard* shardOf(SlotHandle handle) const;
+
+    /**
+     * @brief   Tags a shard's slot handle with the shard index.
+     */
+    static SlotHandle makeHandle(std::size_t shard, SlotHandle handle);
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [ShardedSignal]                                               //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline ShardedSignal<ArgsT...>::ShardedSignal(std::size_t numShards)
+    : m_numShards(1)
+{
+    if (!numShards)
+    {
+        numShards = std::thread::hardware_concurrency();
+    }
+    while (m_numShards < numShards && m_numShards < kMaxShards)
+    {
+        m_numShards <<= 1;
+    }
+    m_shards.reset(new Shard[m_numShards]);
+}
+
+template<typename... ArgsT>
+inline std::size_t ShardedSignal<ArgsT...>::numShards() const
+{
+    return m_numShards;
+}
+
+template<typename... ArgsT>
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline SlotHandle ShardedSignal<ArgsT...>::connect(FuncT&& func)
+{
+    auto shard = localShard();
+    return makeHandle(shard, m_shards[shard].signal.connect(std::forward<FuncT>(func)));
+}
+
+template<typename... ArgsT>
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline SlotHandle ShardedSignal<ArgsT...>::connect(SignalObject* lifetimeGiver, FuncT&& func, 
+    ConnectionType type)
+{
+    auto shard = localShard();
+    return makeHandle(shard, 
+        m_shards[shard].signal.connect(lifetimeGiver, std::forward<FuncT>(func), type));
+}
+
+template<typename... ArgsT>
+template<typename ObjectT, typename... MemberArgsT>
+inline SlotHandle ShardedSignal<ArgsT...>::connect(ObjectT* object, 
+    void(ObjectT::*member)(MemberArgsT...), ConnectionType type)
+{
+    auto shard = localShard();
+    return makeHandle(shard, m_shards[shard].signal.connect(object, member, type));
+}
+
+template<typename... ArgsT>
+inline bool ShardedSignal<ArgsT...>::disconnect(SlotHandle handle)
+{
+    auto shard = shardOf(handle);
+    return shard && shard->signal.disconnect(handle & ((SlotHandle(1) << kSlotHandleBits) - 1));
+}
+
+template<typename... ArgsT>
+inline ScopedConnection ShardedSignal<ArgsT...>::makeScoped(SlotHandle handle)
+{
+    auto shard = shardOf(handle);
+    if (!shard)
+    {
+        return ScopedConnection();
+    }
+    return shard->signal.makeScoped(handle & ((SlotHandle(1) << kSlotHandleBits) - 1));
+}
+
+template<typename... ArgsT>
+inline std::size_t ShardedSignal<ArgsT...>::numSlots() const
+{
+    std::size_t numSlots = 0;
+    for (std::size_t i = 0; i < m_numShards; ++i)
+    {
+        numSlots += m_shards[i].signal.numSlots();
+    }
+    return numSlots;
+}
+
+template<typename... ArgsT>
+inline void ShardedSignal<ArgsT...>::emit(internal::SlotArg<ArgsT>... args) const
+{
+    for (std::size_t i = 0; i < m_numShards; ++i)
+    {
+        m_shards[i].signal.emit(args...);
+    }
+}
+
+template<typename... ArgsT>
+inline void ShardedSignal<ArgsT...>::operator () (internal::SlotArg<ArgsT>... args) const
+{
+    emit(args...);
+}
+
+template<typename... ArgsT>
+inline std::size_t ShardedSignal<ArgsT...>::localShard() const
+{
+    // The shard count is a power of two.
+    return internal::threadOrdinal() & (m_numShards - 1);
+}
+
+template<typename... ArgsT>
+inline typename ShardedSignal<ArgsT...>::Shard* ShardedSignal<ArgsT...>::shardOf(
+    SlotHandle handle) const
+{
+    auto shard = handle >> kSlotHandleBits;
+    return shard < m_numShards ? &m_shards[shard] : nullptr;
+}
+
+template<typename... ArgsT>
+inline SlotHandle ShardedSignal<ArgsT...>::makeHandle(std::size_t shard, SlotHandle handle)
+{
+    return (SlotHandle(shard) << kSlotHandleBits) | handle;
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_SHARDEDSIGNAL_HPP
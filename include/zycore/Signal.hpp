@@ -25,43 +25,442 @@
 #define ZYCORE_SIGNAL_HPP
 
 #include "zycore/Utils.hpp"
+#include "zycore/EventLoop.hpp"
+#include "zycore/ThreadPool.hpp"
+#include "zycore/SignalStats.hpp"
 
-#include <map>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <tuple>
+#include <utility>
+#include <type_traits>
 #include <thread>
 #include <mutex>
+#include <cassert>
 
 namespace zycore
 {
 
 class SignalObject;
 
+/**
+ * @brief   Handle identifying a connection within its signal.
+ *          
+ * The lower half of the bits index the signal's slot table, the bits above hold the generation
+ * of that table entry, which changes whenever the entry is released. A handle of a connection
+ * that no longer exists therefore never refers to a later connection reusing the entry. @c 0 is 
+ * never a valid handle.
+ */
 using SlotHandle = size_t;
 
+/**
+ * @brief   Number of low bits of a slot handle used by a single signal.
+ *          
+ * The remaining bits are always clear, composite signals like @c ShardedSignal use them to tell
+ * their parts apart.
+ */
+const unsigned kSlotHandleBits = sizeof(SlotHandle) * 8 - 8;
+
+/**
+ * @brief   Determines how a slot is invoked when its signal is emitted.
+ */
+enum class ConnectionType
+{
+    /**
+     * @brief   Queued if the slot has an event loop owned by a thread other than the emitting
+     *          one, direct otherwise.
+     */
+    kAuto,
+    /**
+     * @brief   The slot is called synchronously from within @c emit.
+     */
+    kDirect,
+    /**
+     * @brief   The arguments are captured and the slot is called from its event loop.
+     */
+    kQueued,
+};
+
 // ============================================================================================== //
 // Internal base classes                                                                          //
 // ============================================================================================== //
 
 namespace internal 
 {
-    class SignalBase
+    class SignalBase;
+    class SignalObjectBase;
+}
+
+class ScopedConnection;
+
+template<typename... ArgsT>
+class SignalAwaitable;
+
+namespace internal
+{
+    template<typename... ArgsT>
+    class AwaitHub;
+
+    /**
+     * @brief   Type-erased part of a connection.
+     *          
+     * Holds the reference count and state of the connection as well as the links of the two
+     * intrusive lists it is part of: the slot list of its signal and, for connections bound to
+     * an object, the connection list of that object. Both lists are doubly linked, so a
+     * connection is added and removed in constant time from either side.
+     */
+    class ConnectionNode : public NonCopyable
+    {
+        friend class SignalBase;
+        friend class SignalObjectBase;
+        friend class zycore::ScopedConnection;
+        template<typename... ArgsT>
+        friend class AwaitHub;
+    private:
+        std::atomic<std::size_t> m_refCount;
+        std::atomic<bool> m_connected;
+        // Taken when the connection is loosened, keeps the signal alive for lockSignal.
+        std::atomic<bool> m_guard;
+        ConnectionType m_type;
+        // Connections resuming awaiting coroutines aren't counted or instrumented as slots.
+        bool m_awaitHub;
+        SlotHandle m_handle;
+        // Guarded by the signal's mutex.
+        SignalBase* m_signal;
+        ConnectionNode* m_signalPrev;
+        ConnectionNode* m_signalNext;
+        SignalObjectBase* m_object;
+        // Guarded by the object's mutex.
+        ConnectionNode* m_objectPrev;
+        ConnectionNode* m_objectNext;
+    public: // Con- & Destructor.
+        /**
+         * @brief   Constructor.
+         * @param   type    The connection type.
+         */
+        explicit ConnectionNode(ConnectionType type);
+
+        /**
+         * @brief   Destructor.
+         */
+        virtual ~ConnectionNode() = default;
+    public: // Public interface.
+        /**
+         * @brief   Gets the connection type.
+         * @return  The connection type.
+         */
+        ConnectionType type() const;
+
+        /**
+         * @brief   Determines whether the connection is still established.
+         * @return  @c false as soon as the slot was disconnected, else @c true.
+         * @remarks This routine is thread-safe.
+         *
+         * Queued calls that are still pending when the connection is loosened are dropped.
+         */
+        bool isConnected() const;
+
+        /**
+         * @brief   Gets the handle assigned by the signal.
+         * @return  The handle, @c 0 if the connection was never added to a signal.
+         */
+        SlotHandle handle() const;
+
+        /**
+         * @brief   Increments the reference count.
+         */
+        void addRef();
+
+        /**
+         * @brief   Decrements the reference count, destroying the connection when it drops to 0.
+         */
+        void release();
+
+        /**
+         * @brief   Locks the signal the connection belongs to.
+         * @return  The lock, not owning any mutex if the connection has been loosened.
+         * @remarks This routine is thread-safe. Unlike the connection, the signal isn't kept
+         *          alive by references, this is the only safe way to get hold of it.
+         */
+        std::unique_lock<std::recursive_mutex> lockSignal();
+    private:
+        void lockGuard();
+        void unlockGuard();
+
+        /**
+         * @brief   Called by the signal after loosening the connection, with the signal locked.
+         */
+        virtual void onDisconnected() {}
+    };
+
+    /**
+     * @brief   Owning pointer to a reference counted connection.
+     */
+    template<typename T>
+    class IntrusivePtr
     {
-        friend SignalObject;
-        virtual void onSlotsObjectDestroyed(SlotHandle handle) = 0;
+        T* m_ptr;
     public:
-        virtual ~SignalBase() = default;
+        IntrusivePtr() noexcept : m_ptr(nullptr) {}
+        explicit IntrusivePtr(T* ptr) : m_ptr(ptr) { if (m_ptr) m_ptr->addRef(); }
+        IntrusivePtr(const IntrusivePtr& other) : IntrusivePtr(other.m_ptr) {}
+        IntrusivePtr(IntrusivePtr&& other) noexcept : m_ptr(other.m_ptr) { other.m_ptr = nullptr; }
+        ~IntrusivePtr() { if (m_ptr) m_ptr->release(); }
+        IntrusivePtr& operator = (IntrusivePtr other) noexcept 
+        { 
+            std::swap(m_ptr, other.m_ptr); 
+            return *this; 
+        }
+        T* get() const noexcept { return m_ptr; }
+        T* operator -> () const noexcept { return m_ptr; }
+        T& operator * () const noexcept { return *m_ptr; }
+        explicit operator bool () const noexcept { return m_ptr != nullptr; }
     };
 
-    struct SignalObjectBase
+    /**
+     * @brief   Type-erased part of a signal: the slot list, the handle table and the lock.
+     *
+     * Slots are kept in connection order in an intrusive list. Disconnecting a slot while the 
+     * signal is emitting only marks it, the list is swept after the outermost emission, so
+     * slots may freely disconnect themselves or others.
+     */
+    class SignalBase : public NonCopyable
     {
-        template<typename Object, typename... ArgsT>
-        friend class ClassFuncConnection;
+        friend class ConnectionNode;
+        friend class SignalObjectBase;
+        friend class zycore::ScopedConnection;
+        template<typename... ArgsT>
+        friend class AwaitHub;
+    private:
+        static const unsigned kIndexBits = sizeof(SlotHandle) * 4;
+        static const SlotHandle kIndexMask = (SlotHandle(1) << kIndexBits) - 1;
+        static const SlotHandle kNoFreeSlot = kIndexMask;
+        static const SlotHandle kGenerationMask = 
+            (SlotHandle(1) << (kSlotHandleBits - kIndexBits)) - 1;
+
+        /**
+         * @brief   Entry of the slot table, either in use or part of the free list.
+         */
+        struct SlotEntry
+        {
+            ConnectionNode* node;
+            SlotHandle generation;
+            SlotHandle nextFree;
+        };
+    protected:
+        mutable std::recursive_mutex m_mutex;
+        // The list is swept by const emissions, which is not an observable modification.
+        mutable ConnectionNode* m_head;
+        mutable ConnectionNode* m_tail;
+        // Connections resuming coroutines awaiting the signal, see @c SignalAwaitable.
+        ConnectionNode* m_awaitHubs;
+        std::vector<SlotEntry> m_slotTable;
+        SlotHandle m_freeSlot;
+        std::size_t m_numSlots;
+        mutable unsigned m_emitDepth;
+        mutable bool m_sweepPending;
+#ifdef ZYCORE_SIGNAL_STATS
+        mutable SignalStats m_stats;
+#endif
+    protected:
+        /**
+         * @brief   Marks the signal as emitting for its lifetime.
+         */
+        class EmitScope : public NonCopyable
+        {
+            const SignalBase& m_signal;
+        public:
+            explicit EmitScope(const SignalBase& signal);
+            ~EmitScope();
+        };
+    protected: // Con- & Destructor.
+        SignalBase();
+        virtual ~SignalBase();
+    public: // Public interface.
+        /**
+         * @brief   Makes a connection disconnect automatically.
+         * @param   handle  The connection handle.
+         * @return  The scoped connection, empty if @c handle does not refer to a connection.
+         * @remarks This routine is thread-safe.
+         */
+        ScopedConnection makeScoped(SlotHandle handle);
+    protected: // Slot list, all of these must be called with the signal locked.
+        /**
+         * @brief   Adds a connection to the end of the slot list.
+         * @param   node    The connection. A reference is taken.
+         * @param   object  The object to bind the connection's lifetime to, or @c nullptr.
+         * @return  The handle assigned to the connection.
+         */
+        SlotHandle link(ConnectionNode* node, SignalObjectBase* object);
+
+        /**
+         * @brief   Disconnects a connection by its handle.
+         * @param   handle  The slot handle.
+         * @return  @c true on success, @c false if the connection didn't exist.
+         */
+        bool unlink(SlotHandle handle);
+
+        /**
+         * @brief   Looks up a connection by its handle.
+         * @param   handle  The slot handle.
+         * @return  The connection or @c nullptr for stale and invalid handles.
+         */
+        ConnectionNode* lookup(SlotHandle handle) const;
+
+        /**
+         * @brief   Disconnects a connection.
+         * @param   node            The connection. Must be connected to this signal.
+         * @param   objectDestroyed @c true if called due to the destruction of the connection's
+         *                          object.
+         */
+        void disconnectNode(ConnectionNode* node, bool objectDestroyed);
+
+        /**
+         * @brief   Gets the first connected slot.
+         * @return  The slot or @c nullptr if there is none.
+         */
+        ConnectionNode* firstSlot() const;
 
+        /**
+         * @brief   Gets the connected slot following the given one.
+         * @param   node    The current slot.
+         * @return  The slot or @c nullptr if @c node is the last one.
+         */
+        static ConnectionNode* nextSlot(const ConnectionNode* node);
+
+        /**
+         * @brief   Determines whether a slot resumes coroutines awaiting the signal.
+         * @param   node    The slot.
+         * @return  @c true for the hubs created by @c Signal::next, else @c false.
+         */
+        static bool isAwaitHub(const ConnectionNode* node);
+    private:
+        void unlinkFromSignal(ConnectionNode* node) const;
+        void sweep() const;
+    };
+
+    /**
+     * @brief   Base class of objects connections can be bound to, see @c SignalObject.
+     */
+    class SignalObjectBase
+    {
+        friend class SignalBase;
+    private:
+        std::recursive_mutex m_connectionsMutex;
+        ConnectionNode* m_connections;
+    public:
+        SignalObjectBase();
         virtual ~SignalObjectBase() = default;
-        virtual void onSignalConnected(SignalBase *signal, SlotHandle handle) = 0;
-        virtual void onSignalDisconnected(SignalBase *signal, SlotHandle handle) = 0;
+        virtual EventLoop* eventLoop() const = 0;
+    protected:
+        /**
+         * @brief   Disconnects all connections bound to this object.
+         *          
+         * The object's lock is taken first here, while connecting and disconnecting from the
+         * signal's side lock the signal first. To not dead-lock against those, signals are only
+         * try-locked and the object's lock is released and retaken on contention.
+         */
+        void disconnectAll();
+    private:
+        void attach(ConnectionNode* node);
+        void detach(ConnectionNode* node);
     };
+
+    /**
+     * @brief   The type a slot receives an argument of type @c T as.
+     *          
+     * References are passed through, everything else is passed by constant reference, so
+     * emitting a signal never copies its arguments by itself.
+     */
+    template<typename T>
+    using SlotArg = std::conditional_t<std::is_reference<T>::value, T, const T&>;
+
+    template<typename FuncT, typename ArgsTupleT, typename=void>
+    struct IsSlotImpl : std::false_type {};
+
+    template<typename FuncT, typename... ArgsT>
+    struct IsSlotImpl<FuncT, std::tuple<ArgsT...>, 
+            decltype(void(std::declval<std::decay_t<FuncT>&>()(std::declval<SlotArg<ArgsT>>()...)))>
+        : std::true_type {};
+
+    /**
+     * @brief   Determines whether @c FuncT can be connected to a @c Signal<ArgsT...>.
+     */
+    template<typename FuncT, typename... ArgsT>
+    using IsSlot = IsSlotImpl<FuncT, std::tuple<ArgsT...>>;
+
+    /**
+     * @brief   Calls a function with the elements of a tuple as arguments.
+     */
+    template<typename FuncT, typename TupleT, std::size_t... idxT>
+    inline void applyTuple(FuncT&& func, TupleT& tuple, std::index_sequence<idxT...>)
+    {
+        func(std::get<idxT>(tuple)...);
+    }
 } // namespace internal
 
+// ============================================================================================== //
+// [ScopedConnection]                                                                             //
+// ============================================================================================== //
+
+/**
+ * @brief   Connection disconnected automatically when the handle goes out of scope.
+ *          
+ * Obtained through @c makeScoped of the signal. Scoped connections keep the connection's state
+ * alive, but not the signal: if the signal was destroyed first, or the connection was loosened 
+ * otherwise, destroying the handle neither touches the signal nor takes any lock.
+ */
+class ScopedConnection
+{
+    friend class internal::SignalBase;
+    internal::IntrusivePtr<internal::ConnectionNode> m_node;
+private:
+    explicit ScopedConnection(internal::ConnectionNode* node);
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructs an empty scoped connection.
+     */
+    ScopedConnection() = default;
+
+    /**
+     * @brief   Move constructor.
+     */
+    ScopedConnection(ScopedConnection&& other) noexcept = default;
+
+    /**
+     * @brief   Move assignment. Disconnects the connection previously held.
+     */
+    ScopedConnection& operator = (ScopedConnection&& other) noexcept;
+
+    /**
+     * @brief   Destructor. Disconnects the connection.
+     */
+    ~ScopedConnection();
+
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator = (const ScopedConnection&) = delete;
+public: // Public interface.
+    /**
+     * @brief   Determines whether the connection is still established.
+     * @return  @c true if connected, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief   Disconnects the connection.
+     * @remarks This routine is thread-safe.
+     */
+    void disconnect();
+
+    /**
+     * @brief   Gives up the scope, the connection stays established.
+     * @return  The slot handle, @c 0 if the handle was empty.
+     */
+    SlotHandle release();
+};
+
 // ============================================================================================== //
 // [ConnectionBase]                                                                               //
 // ============================================================================================== //
@@ -71,34 +470,62 @@ namespace internal
  * @tparam  ArgsT The slot's argument types.
  */
 template<typename... ArgsT>
-struct ConnectionBase
+struct ConnectionBase : public internal::ConnectionNode
 {
     template<typename...>
     friend class Signal;
+private:
+#ifdef ZYCORE_SIGNAL_STATS
+    SignalStats::SlotHistogramPtr m_latency;
+#endif
 public: // Public interface.
     /**
-     * @brief   Default constructor.
+     * @brief   Constructor.
+     * @param   type    The connection type.
      */
-    ConnectionBase() = default;
+    explicit ConnectionBase(ConnectionType type = ConnectionType::kDirect);
 
     /**
-     * @brief   Destructor.
+     * @brief   Calls the connected slot.
+     * @param   args The arguments.
      */
-    virtual ~ConnectionBase() = default;
+    virtual void call(internal::SlotArg<ArgsT>... args) const = 0;
 
     /**
-     * @brief   Calls the connected slot.
+     * @brief   Calls the connected slot, allowing it to take over the arguments.
+     * @param   args The arguments.
+     *              
+     * The default implementation forwards to @c call.
+     */
+    virtual void callMove(ArgsT&&... args) const;
+
+    /**
+     * @brief   Gets the event loop queued calls are delivered to.
+     * @return  The event loop or @c nullptr if the slot can only be called directly.
+     */
+    virtual EventLoop* eventLoop() const;
+
+    /**
+     * @brief   Gets the object the connection's lifetime is bound to.
+     * @return  The object or @c nullptr if the connection is not bound to one.
+     */
+    virtual internal::SignalObjectBase* lifetimeObject() const;
+
+    /**
+     * @brief   Calls the slot the way a signal does, recording the call's latency when signals
+     *          are instrumented.
      * @param   args The arguments.
      */
-    virtual void call(ArgsT... args) const = 0;
-private: // Private interface.
+    void dispatch(internal::SlotArg<ArgsT>... args) const;
+
     /**
-     * @brief   Called when connection is destroyed.
-     * @param   handle  The slot handle.
+     * @brief   @c callMove counterpart of @c dispatch.
+     * @param   args The arguments.
      */
-    virtual void onDestroy(SlotHandle handle) = 0;
+    void dispatchMove(ArgsT&&... args) const;
 };
 
+
 // ============================================================================================== //
 // [FuncConnection]                                                                               //
 // ============================================================================================== //
@@ -106,6 +533,9 @@ private: // Private interface.
 /**
  * @brief   Connection between static slot and signal.
  * @tparam  ArgsT The slot's argument types.
+ *                
+ * The slot is stored as a @c std::function taking its arguments by value, which copies them for 
+ * every call. Slots connected through @c Signal::connect are stored as @c FunctorConnection.
  */
 template<typename... ArgsT>
 class FuncConnection
@@ -118,16 +548,67 @@ public:
      * @param   func The slot to be connected.
      */
     explicit FuncConnection(Function func);
+
+    /**
+     * @brief   Constructor.
+     * @param   func    The slot to be connected.
+     * @param   loop    The event loop queued calls are delivered to.
+     * @param   type    The connection type.
+     */
+    FuncConnection(Function func, EventLoop* loop, ConnectionType type);
 public: // Implementation of public, virtual member-functions.
     /**
      * @brief   Calls the slot.
      * @param   args  Arguments.
      */
-    virtual void call(ArgsT... args) const override;
+    virtual void call(internal::SlotArg<ArgsT>... args) const override;
+
+    /**
+     * @brief   Calls the slot, moving the arguments.
+     * @param   args  Arguments.
+     */
+    virtual void callMove(ArgsT&&... args) const override;
+
+    /**
+     * @brief   Gets the event loop queued calls are delivered to.
+     */
+    virtual EventLoop* eventLoop() const override;
 private:
     Function m_func;
-private: // Implementation of private interface.
-    virtual void onDestroy(SlotHandle /*handle*/) override {}
+    EventLoop* m_eventLoop;
+};
+
+// ============================================================================================== //
+// [FunctorConnection]                                                                            //
+// ============================================================================================== //
+
+/**
+ * @brief   Connection between a callable of arbitrary type and a signal.
+ * @tparam  FuncT The type of the callable.
+ * @tparam  ArgsT The signal's argument types.
+ *                
+ * The callable is stored with its own type, so the arguments reach the slot exactly as passed to
+ * @c call: a slot taking constant references is called without any copies being made.
+ */
+template<typename FuncT, typename... ArgsT>
+class FunctorConnection
+    : public ConnectionBase<ArgsT...>
+{
+    FuncT m_func;
+    EventLoop* m_eventLoop;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   func    The slot to be connected.
+     * @param   loop    The event loop queued calls are delivered to.
+     * @param   type    The connection type.
+     */
+    explicit FunctorConnection(FuncT func, EventLoop* loop = nullptr, 
+        ConnectionType type = ConnectionType::kDirect);
+public: // Implementation of public, virtual member-functions.
+    void call(internal::SlotArg<ArgsT>... args) const override;
+    void callMove(ArgsT&&... args) const override;
+    EventLoop* eventLoop() const override;
 };
 
 // ============================================================================================== //
@@ -137,33 +618,35 @@ private: // Implementation of private interface.
 /**
  * @brief   Connection automatically loosened when either the signal or the lifetime-giving objects
  *          is destoyed.
- * @tparam  ArgsT   The slot's member function argument types.
+ * @tparam  FuncT   The type of the callable.
+ * @tparam  ArgsT   The signal's argument types.
  */
-template<typename... ArgsT>
+template<typename FuncT, typename... ArgsT>
 class LifetimedConnection
     : public ConnectionBase<ArgsT...>
-    , public NonCopyable
 {
 public:
-    using Function = std::function<void(ArgsT...)>;
+    using Function = FuncT;
 private:
     Function m_func;
-    internal::SignalBase* m_signal;
     internal::SignalObjectBase* m_lifetimeObject;
 public: // Constructor
     /**
      * @brief   Constructor.
      * @param   obj     The object whose lifetime to bind to.
      * @param   func    The callback function.
-     * @param   sig     The signal to connect to.
-     * @param   handle  The slot handle.
+     * @param   type    The connection type. Queued calls are delivered to the event loop the
+     *                  lifetime-giving object has affinity to.
+     *                  
+     * The connection is bound to the object once it is added to a signal.
      */
     LifetimedConnection(internal::SignalObjectBase *obj, Function func, 
-        internal::SignalBase* sig, SlotHandle handle);
+        ConnectionType type = ConnectionType::kDirect);
 public: // Implementation of public interface.
-    void call(ArgsT... args) const override;
-private: // Implementation of private interface.
-    void onDestroy(SlotHandle handle) override;
+    void call(internal::SlotArg<ArgsT>... args) const override;
+    void callMove(ArgsT&&... args) const override;
+    EventLoop* eventLoop() const override;
+    internal::SignalObjectBase* lifetimeObject() const override;
 };
 
 // ============================================================================================== //
@@ -173,18 +656,69 @@ private: // Implementation of private interface.
 namespace internal
 {
 
+template<typename ObjectT, typename SignatureT>
+class MemberFuncBinding;
+
 /**
  * @brief   Binds @c this to a member-function without the need of placeholders.
+ * @tparam  ObjectT     The object type.
+ * @tparam  SignatureT  The member-function's signature, e.g. @c void(int).
+ *          
+ * The arguments are forwarded, so the member-function's parameter types decide whether they
+ * are copied.
  */
-template<typename ObjectT, typename... ArgsT>
-class MemberFuncBinding
+template<typename ObjectT, typename ResultT, typename... ArgsT>
+class MemberFuncBinding<ObjectT, ResultT(ArgsT...)>
 {
-    using Member = void (ObjectT::*)(ArgsT...);
+    using Member = ResultT (ObjectT::*)(ArgsT...);
     ObjectT* m_obj;
     Member m_member;
 public:
     MemberFuncBinding(ObjectT* obj, Member memberFunc);
-    void operator() (ArgsT... args);
+    template<typename... CallArgsT>
+    ResultT operator() (CallArgsT&&... args) const;
+};
+
+} // namespace internal
+
+// ============================================================================================== //
+// [internal::AsyncEmission]                                                                      //
+// ============================================================================================== //
+
+namespace internal
+{
+
+/**
+ * @brief   State of a signal emission whose slots are run as tasks on a thread pool.
+ */
+template<typename... ArgsT>
+class AsyncEmission : public CompletionState
+{
+public:
+    using ConnectionPtr = IntrusivePtr<ConnectionBase<ArgsT...>>;
+private:
+    std::vector<ConnectionPtr> m_slots;
+    std::tuple<std::decay_t<ArgsT>...> m_args;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   pool    The pool the slots are run on.
+     * @param   slots   The slots to call. May NOT be empty.
+     * @param   args    The arguments the slots are called with.
+     */
+    AsyncEmission(ThreadPool* pool, std::vector<ConnectionPtr> slots, SlotArg<ArgsT>... args);
+
+    /**
+     * @brief   Gets the number of slots to call.
+     * @return  The number of slots.
+     */
+    std::size_t numSlots() const;
+
+    /**
+     * @brief   Calls a slot and marks its task as done.
+     * @param   index   The index of the slot.
+     */
+    void run(std::size_t index);
 };
 
 } // namespace internal
@@ -203,13 +737,11 @@ public:
 template<typename... ArgsT>
 class Signal 
     : public internal::SignalBase
-    , public NonCopyable
 {
-    // Typedefs and private member-variables  
-    using ConnectionBase = ConnectionBase<ArgsT...>;
-    std::map<SlotHandle, ConnectionBase*> m_slots;
-    SlotHandle m_IdCtr;
-    mutable std::recursive_mutex m_mutex;
+    // Typedefs  
+    using Connection = ConnectionBase<ArgsT...>;
+    using ConnectionPtr = internal::IntrusivePtr<Connection>;
+    using ArgsTuple = std::tuple<std::decay_t<ArgsT>...>;
 public: // Con- & Destructor.
     /**
      * @brief   Default constructor.
@@ -231,8 +763,22 @@ public: // Public interface.
     /**
      * @brief   Connects a static slot to the signal.
      * @param   func The function/lambda to connect.
+     *               
+     * The slot is called with constant references to the emitted arguments, slots taking their
+     * parameters by constant reference therefore never copy them.
      */
-    SlotHandle connect(typename FuncConnection<ArgsT...>::Function func);
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    SlotHandle connect(FuncT&& func);
+
+    /**
+     * @brief   Connects a static slot to the signal, delivering calls through an event loop.
+     * @param   loop    The event loop the slot is called from. May NOT be @c nullptr.
+     * @param   func    The function/lambda to connect.
+     * @param   type    The connection type.
+     */
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    SlotHandle connect(EventLoop* loop, FuncT&& func, 
+        ConnectionType type = ConnectionType::kQueued);
 
     /**
      * @brief   Disconnects an existing connetion by it's handle
@@ -241,34 +787,122 @@ public: // Public interface.
      */
     bool disconnect(SlotHandle handle);
 
+    /**
+     * @brief   Gets the number of connected slots.
+     * @return  The number of slots, not counting coroutines awaiting the signal.
+     * @remarks This routine is thread-safe.
+     */
+    std::size_t numSlots() const;
+
     /**
      * @brief   Emits the signal and calls all connected slots.
      * @param   args  Arguments to be passed to the slots.
+     *
+     * Direct slots are called before @c emit returns and receive the arguments by constant 
+     * reference. For queued slots, the arguments are copied once per emission and shared by all
+     * queued deliveries.
+     */
+    void emit(internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Emits the signal, moving the arguments into the last slot.
+     * @param   args  Arguments to be passed to the slots.
+     *
+     * All slots but the last one receive the arguments by constant reference, just like with 
+     * @c emit. The last slot may take them over, so a slot taking its parameters by value gets
+     * them moved rather than copied.
      */
-    void emit(ArgsT... args) const;
+    void emitMove(ArgsT... args) const;
 
     /**
      * @brief   Shorthand for @c emit.
      */
-    void operator () (ArgsT... args) const;
+    void operator () (internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Calls a single slot the way @c emit would.
+     * @param   handle  The handle of the slot to call.
+     * @param   args    Arguments to be passed to the slot.
+     * @return  @c true if the slot was called or its call queued, @c false if the connection 
+     *          didn't exist.
+     */
+    bool emitTo(SlotHandle handle, internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Emits the signal, running the direct slots concurrently on a thread pool.
+     * @param   pool  The pool to run the slots on.
+     * @param   args  Arguments to be passed to the slots.
+     * @return  A handle to wait for the slots to finish.
+     *
+     * Every direct slot becomes a task of its own, so the slots have to be independent of each 
+     * other. The arguments are copied once and shared by all tasks. Queued slots are delivered 
+     * to their event loops and awaiting coroutines are resumed just like with @c emit. Objects
+     * whose slots are connected must not be destroyed before the returned handle is done.
+     */
+    Completion emitAsync(ThreadPool& pool, internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Emits the signal, running the direct slots concurrently on the global pool.
+     * @copydetails emitAsync(ThreadPool&, internal::SlotArg<ArgsT>...)
+     */
+    Completion emitAsync(internal::SlotArg<ArgsT>... args) const;
 
     /**
      * @brief   Shorthand for @c connect.
      * @param   func  The function (slot) to connect with the signal.
      * @return  This instance.
      */
-    Signal& operator += (typename FuncConnection<ArgsT...>::Function func);
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    Signal& operator += (FuncT&& func);
+
+    /**
+     * @brief   Awaits the next emission from a coroutine, resuming it on the emitting thread.
+     * @param   lifetimeObject  An object cancelling the wait when it is destroyed, may be 
+     *                          @c nullptr.
+     * @return  The awaitable, see @c SignalAwaitable.
+     *          
+     * Requires C++20 coroutines and including @c zycore/SignalAwaitable.hpp, which defines the
+     * @c next overloads.
+     */
+    SignalAwaitable<ArgsT...> next(SignalObject* lifetimeObject = nullptr);
+
+    /**
+     * @brief   Awaits the next emission from a coroutine, resuming it on an event loop.
+     * @param   loop            The event loop to resume the coroutine from.
+     * @param   lifetimeObject  An object cancelling the wait when it is destroyed, may be 
+     *                          @c nullptr.
+     * @return  The awaitable, see @c SignalAwaitable.
+     */
+    SignalAwaitable<ArgsT...> next(EventLoop& loop, SignalObject* lifetimeObject = nullptr);
+
+    /**
+     * @brief   Awaits the next emission from a coroutine, resuming it as a thread pool task.
+     * @param   pool            The thread pool to resume the coroutine on.
+     * @param   lifetimeObject  An object cancelling the wait when it is destroyed, may be 
+     *                          @c nullptr.
+     * @return  The awaitable, see @c SignalAwaitable.
+     */
+    SignalAwaitable<ArgsT...> next(ThreadPool& pool, SignalObject* lifetimeObject = nullptr);
+
+#ifdef ZYCORE_SIGNAL_STATS
+    /**
+     * @brief   Gets the instrumentation state of this signal.
+     * @return  The statistics.
+     *
+     * Only available when compiled with @c ZYCORE_SIGNAL_STATS.
+     */
+    SignalStats& stats();
+#endif
 
     /**
      * @brief   Adds a given connection to the internal list.
      * @param   connection The connection to be added. Ownership is transfered.
      */
-    template<typename Object>
-    SlotHandle connect(LifetimedConnection<Object, ArgsT...>* connection)
+    template<typename FuncT>
+    SlotHandle connect(LifetimedConnection<FuncT, ArgsT...>* connection)
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        m_slots.emplace(m_IdCtr, connection);
-        return m_IdCtr++;
+        return addSlot(connection);
     }
 
     /**
@@ -276,193 +910,956 @@ public: // Public interface.
      *          signal object.
      * @param   object The object to be connected.
      * @param	member The member function.
+     * @param   type   The connection type. Queued calls are delivered to the event loop the
+     *                 object has affinity to, see @c SignalObject::eventLoop.
      *                 
      * The connection is automatically released as soon as either the signal or the
      * lifetime-giver is destroyed.
      */
-    SlotHandle connect(SignalObject* lifetimeGiver, std::function<void(ArgsT...)> func)
+    template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int> = 0>
+    SlotHandle connect(SignalObject* lifetimeGiver, FuncT&& func,
+        ConnectionType type = ConnectionType::kAuto)
     {
+        using ConnectionT = LifetimedConnection<std::decay_t<FuncT>, ArgsT...>;
+        auto connection = new ConnectionT(lifetimeGiver, std::forward<FuncT>(func), type);
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        SlotHandle handle = m_IdCtr++;
-        m_slots.emplace(handle, new LifetimedConnection<ArgsT...>(
-            lifetimeGiver, func, this, handle));
-        return handle;
+        return addSlot(connection);
     }
 
     /**
      * @brief   Connects a member-function slot to the signal.
      * @param   object The object to be connected.
      * @param	member The member function.
+     * @param   type   The connection type.
      *                 
      * The connection is automatically released as soon as either the signal or the object
-     * with the slot is destroyed.
+     * with the slot is destroyed. The member-function's parameters may differ from the signal's
+     * argument types as long as the arguments convert, e.g. @c const\ std::string& for a 
+     * @c std::string argument, which avoids copying it.
      */
-    template<typename ObjectT>
-    SlotHandle connect(ObjectT* object, void(ObjectT::*member)(ArgsT...))
+    template<typename ObjectT, typename... MemberArgsT>
+    SlotHandle connect(ObjectT* object, void(ObjectT::*member)(MemberArgsT...), 
+        ConnectionType type = ConnectionType::kAuto)
     {
         static_assert(std::is_base_of<SignalObject, ObjectT>::value,
             "type has to be derived from SignalObject");
-        return connect(object, internal::MemberFuncBinding<ObjectT, ArgsT...>(object, member));
+        static_assert(sizeof...(MemberArgsT) == sizeof...(ArgsT),
+            "member-function has to take as many arguments as the signal provides");
+        return connect(object, 
+            internal::MemberFuncBinding<ObjectT, void(MemberArgsT...)>(object, member), type);
     }
-private: // Interface for SignalObject.
+private: // Internal helpers.
+    /**
+     * @brief   Adds a connection to the slot list.
+     * @param   connection  The connection. Ownership is transfered.
+     * @return  The slot handle.
+     * @remarks Must be called with the signal locked.
+     */
+    SlotHandle addSlot(Connection* connection);
+
+    /**
+     * @brief   Gets the connection resuming coroutines waiting with the given lifetime object,
+     *          creating it on first use.
+     * @remarks The reference is taken with the signal locked, the connection may be loosened
+     *          by a concurrent destruction of the lifetime object right afterwards.
+     */
+    internal::IntrusivePtr<internal::AwaitHub<ArgsT...>> awaitHub(SignalObject* lifetimeObject);
+
+    /**
+     * @brief   Determines whether a call to the given connection has to be queued.
+     * @param   connection  The connection.
+     * @return  The event loop to queue the call to or @c nullptr for a direct call.
+     */
+    static EventLoop* queueFor(const Connection& connection);
+
     /**
-     * @brief   Callback used by slots when they are destroyed.
+     * @brief   Queues a call to the given connection to an event loop.
+     * @param   loop        The event loop to deliver to.
+     * @param   connection  The connection to call.
+     * @param   queuedArgs  The arguments shared by all queued calls of the emission. Created on 
+     *                      first use.
+     * @param   args        The emitted arguments.
      */
-    void onSlotsObjectDestroyed(SlotHandle handle) override;
+    static void postQueued(EventLoop* loop, Connection* connection, 
+        std::shared_ptr<ArgsTuple>& queuedArgs, internal::SlotArg<ArgsT>... args);
 };
 
 // ============================================================================================== //
-// Implementation of inline methods [FuncConnection]                                              //
+// ============================================================================================== //
+// Implementation of inline methods [internal::ConnectionNode]                                    //
 // ============================================================================================== //
 
-template<typename... ArgsT>
-inline FuncConnection<ArgsT...>::FuncConnection(Function func)
-    : m_func(func)
+namespace internal
+{
+
+inline ConnectionNode::ConnectionNode(ConnectionType type)
+    : m_refCount(0)
+    , m_connected(true)
+    , m_guard(false)
+    , m_type(type)
+    , m_awaitHub(false)
+    , m_handle(0)
+    , m_signal(nullptr)
+    , m_signalPrev(nullptr)
+    , m_signalNext(nullptr)
+    , m_object(nullptr)
+    , m_objectPrev(nullptr)
+    , m_objectNext(nullptr)
 {}
 
-template<typename... ArgsT>
-inline void FuncConnection<ArgsT...>::call(ArgsT... args) const
+inline ConnectionType ConnectionNode::type() const
 {
-    m_func(args...);
+    return m_type;
 }
 
-// ============================================================================================== //
-// Implementation of inline methods [LifetimedConnection]                                         //
-// ============================================================================================== //
-
-template<typename... ArgsT>
-inline LifetimedConnection<ArgsT...>::LifetimedConnection(internal::SignalObjectBase *lifetimeObj, 
-        Function func, internal::SignalBase* sig, SlotHandle handle)
-    : m_func(func)
-    , m_signal(sig)
-    , m_lifetimeObject(lifetimeObj)
+inline bool ConnectionNode::isConnected() const
 {
-    lifetimeObj->onSignalConnected(sig, handle);
+    return m_connected.load(std::memory_order_acquire);
 }
 
-template<typename... ArgsT>
-inline void LifetimedConnection<ArgsT...>::call(ArgsT... args) const
+inline SlotHandle ConnectionNode::handle() const
 {
-    m_func(args...);
+    return m_handle;
 }
 
-template<typename... ArgsT>
-inline void LifetimedConnection<ArgsT...>::onDestroy(SlotHandle handle)
+inline void ConnectionNode::addRef()
 {
-    m_lifetimeObject->onSignalDisconnected(m_signal, handle);
+    m_refCount.fetch_add(1, std::memory_order_relaxed);
 }
 
-// ============================================================================================== //
-// Implementation of inline functions [internal::MemberFuncBinding]                               //
-// ============================================================================================== //
+inline void ConnectionNode::release()
+{
+    if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
 
-namespace internal
+inline std::unique_lock<std::recursive_mutex> ConnectionNode::lockSignal()
 {
+    while (isConnected())
+    {
+        // While the guard is held, the connection cannot be loosened, so the signal has to be 
+        // alive if it is still connected. Signals hold their lock while loosening connections, 
+        // hence only try-locking it here.
+        lockGuard();
+        if (!isConnected())
+        {
+            unlockGuard();
+            break;
+        }
 
-template<typename ObjectT, typename... ArgsT>
-inline MemberFuncBinding<ObjectT, ArgsT...>::MemberFuncBinding(ObjectT* obj, Member memberFunc)
-    : m_obj(obj)
-    , m_member(memberFunc)
-{}
+        std::unique_lock<std::recursive_mutex> lock(m_signal->m_mutex, std::try_to_lock);
+        unlockGuard();
+        if (lock.owns_lock())
+        {
+            if (isConnected())
+            {
+                return lock;
+            }
+            break;
+        }
+        std::this_thread::yield();
+    }
+    return std::unique_lock<std::recursive_mutex>();
+}
+
+inline void ConnectionNode::lockGuard()
+{
+    while (m_guard.exchange(true, std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
 
-template<typename ObjectT, typename... ArgsT>
-inline void MemberFuncBinding<ObjectT, ArgsT...>::operator() (ArgsT... args)
+inline void ConnectionNode::unlockGuard()
 {
-    (m_obj->*m_member)(args...);
+    m_guard.store(false, std::memory_order_release);
 }
 
 } // namespace internal
 
+// ============================================================================================== //
+// Implementation of inline methods [internal::SignalBase]                                        //
+// ============================================================================================== //
+
+namespace internal
+{
+
+inline SignalBase::EmitScope::EmitScope(const SignalBase& signal)
+    : m_signal(signal)
+{
+    ++m_signal.m_emitDepth;
+}
+
+inline SignalBase::EmitScope::~EmitScope()
+{
+    if (--m_signal.m_emitDepth == 0 && m_signal.m_sweepPending)
+    {
+        m_signal.sweep();
+    }
+}
+
+inline SignalBase::SignalBase()
+    : m_head(nullptr)
+    , m_tail(nullptr)
+    , m_awaitHubs(nullptr)
+    , m_freeSlot(kNoFreeSlot)
+    , m_numSlots(0)
+    , m_emitDepth(0)
+    , m_sweepPending(false)
+#ifdef ZYCORE_SIGNAL_STATS
+    , m_stats(this)
+#endif
+{}
+
+inline SignalBase::~SignalBase()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_emitDepth = 0;
+    while (m_head)
+    {
+        auto node = m_head;
+        if (node->isConnected())
+        {
+            disconnectNode(node, false);
+        }
+        else
+        {
+            unlinkFromSignal(node);
+        }
+    }
+}
+
+inline ScopedConnection SignalBase::makeScoped(SlotHandle handle)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return ScopedConnection(lookup(handle));
+}
+
+inline SlotHandle SignalBase::link(ConnectionNode* node, SignalObjectBase* object)
+{
+    SlotHandle index;
+    if (m_freeSlot != kNoFreeSlot)
+    {
+        index = m_freeSlot;
+        m_freeSlot = m_slotTable[index].nextFree;
+    }
+    else
+    {
+        index = m_slotTable.size();
+        m_slotTable.push_back(SlotEntry{nullptr, 1, kNoFreeSlot});
+    }
+    m_slotTable[index].node = node;
+    if (!node->m_awaitHub)
+    {
+        ++m_numSlots;
+    }
+
+    node->addRef();
+    node->m_handle = (m_slotTable[index].generation << kIndexBits) | index;
+    node->m_signal = this;
+    node->m_signalPrev = m_tail;
+    node->m_signalNext = nullptr;
+    (m_tail ? m_tail->m_signalNext : m_head) = node;
+    m_tail = node;
+
+    if (object)
+    {
+        node->m_object = object;
+        object->attach(node);
+    }
+    return node->m_handle;
+}
+
+inline bool SignalBase::unlink(SlotHandle handle)
+{
+    auto node = lookup(handle);
+    if (!node) return false;
+    disconnectNode(node, false);
+    return true;
+}
+
+inline ConnectionNode* SignalBase::lookup(SlotHandle handle) const
+{
+    auto index = handle & kIndexMask;
+    if (index >= m_slotTable.size() || m_slotTable[index].generation != handle >> kIndexBits)
+    {
+        return nullptr;
+    }
+    return m_slotTable[index].node;
+}
+
+inline void SignalBase::disconnectNode(ConnectionNode* node, bool objectDestroyed)
+{
+    assert(node->m_signal == this && node->isConnected());
+    node->lockGuard();
+    node->m_connected.store(false, std::memory_order_release);
+    node->unlockGuard();
+
+    // Bumping the generation invalidates all handles of the entry, wrapping around to 1.
+    auto& entry = m_slotTable[node->m_handle & kIndexMask];
+    entry.node = nullptr;
+    entry.generation = (entry.generation + 1) & kGenerationMask;
+    if (!entry.generation) ++entry.generation;
+    entry.nextFree = m_freeSlot;
+    m_freeSlot = node->m_handle & kIndexMask;
+    if (!node->m_awaitHub)
+    {
+        --m_numSlots;
+    }
+    if (node->m_object)
+    {
+        node->m_object->detach(node);
+        node->m_object = nullptr;
+    }
+
+#ifdef ZYCORE_SIGNAL_STATS
+    if (!node->m_awaitHub)
+    {
+        m_stats.onDisconnect(node->m_handle, objectDestroyed);
+    }
+#else
+    (void)objectDestroyed;
+#endif
+    node->onDisconnected();
+
+    // Emissions in progress may currently be calling the node or hold a pointer to its 
+    // successor, unlinking is deferred until they are done.
+    if (m_emitDepth)
+    {
+        m_sweepPending = true;
+    }
+    else
+    {
+        unlinkFromSignal(node);
+    }
+}
+
+inline ConnectionNode* SignalBase::firstSlot() const
+{
+    auto node = m_head;
+    while (node && !node->isConnected())
+    {
+        node = node->m_signalNext;
+    }
+    return node;
+}
+
+inline ConnectionNode* SignalBase::nextSlot(const ConnectionNode* node)
+{
+    auto next = node->m_signalNext;
+    while (next && !next->isConnected())
+    {
+        next = next->m_signalNext;
+    }
+    return next;
+}
+
+inline bool SignalBase::isAwaitHub(const ConnectionNode* node)
+{
+    return node->m_awaitHub;
+}
+
+inline void SignalBase::unlinkFromSignal(ConnectionNode* node) const
+{
+    (node->m_signalPrev ? node->m_signalPrev->m_signalNext : m_head) = node->m_signalNext;
+    (node->m_signalNext ? node->m_signalNext->m_signalPrev : m_tail) = node->m_signalPrev;
+    node->m_signalPrev = nullptr;
+    node->m_signalNext = nullptr;
+    node->release();
+}
+
+inline void SignalBase::sweep() const
+{
+    m_sweepPending = false;
+    for (auto node = m_head; node;)
+    {
+        auto next = node->m_signalNext;
+        if (!node->isConnected())
+        {
+            unlinkFromSignal(node);
+        }
+        node = next;
+    }
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::SignalObjectBase]                                  //
+// ============================================================================================== //
+
+namespace internal
+{
+
+inline SignalObjectBase::SignalObjectBase()
+    : m_connections(nullptr)
+{}
+
+inline void SignalObjectBase::disconnectAll()
+{
+    for (;;)
+    {
+        std::unique_lock<std::recursive_mutex> objectLock(m_connectionsMutex);
+        auto node = m_connections;
+        if (!node)
+        {
+            return;
+        }
+
+        // The node cannot leave this list without our lock, so its signal is still alive.
+        auto signal = node->m_signal;
+        std::unique_lock<std::recursive_mutex> signalLock(signal->m_mutex, std::try_to_lock);
+        if (!signalLock.owns_lock())
+        {
+            objectLock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        signal->disconnectNode(node, true);
+    }
+}
+
+inline void SignalObjectBase::attach(ConnectionNode* node)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_connectionsMutex);
+    node->m_objectPrev = nullptr;
+    node->m_objectNext = m_connections;
+    if (m_connections)
+    {
+        m_connections->m_objectPrev = node;
+    }
+    m_connections = node;
+}
+
+inline void SignalObjectBase::detach(ConnectionNode* node)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_connectionsMutex);
+    (node->m_objectPrev ? node->m_objectPrev->m_objectNext : m_connections) = node->m_objectNext;
+    if (node->m_objectNext)
+    {
+        node->m_objectNext->m_objectPrev = node->m_objectPrev;
+    }
+    node->m_objectPrev = nullptr;
+    node->m_objectNext = nullptr;
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [ScopedConnection]                                            //
+// ============================================================================================== //
+
+inline ScopedConnection::ScopedConnection(internal::ConnectionNode* node)
+    : m_node(node)
+{}
+
+inline ScopedConnection& ScopedConnection::operator = (ScopedConnection&& other) noexcept
+{
+    if (this != &other)
+    {
+        disconnect();
+        m_node = std::move(other.m_node);
+    }
+    return *this;
+}
+
+inline ScopedConnection::~ScopedConnection()
+{
+    disconnect();
+}
+
+inline bool ScopedConnection::isConnected() const
+{
+    return m_node && m_node->isConnected();
+}
+
+inline void ScopedConnection::disconnect()
+{
+    if (!m_node)
+    {
+        return;
+    }
+
+    auto lock = m_node->lockSignal();
+    if (lock.owns_lock())
+    {
+        m_node->m_signal->disconnectNode(m_node.get(), false);
+    }
+    m_node = internal::IntrusivePtr<internal::ConnectionNode>();
+}
+
+inline SlotHandle ScopedConnection::release()
+{
+    auto handle = m_node ? m_node->handle() : 0;
+    m_node = internal::IntrusivePtr<internal::ConnectionNode>();
+    return handle;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [ConnectionBase]                                              //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline ConnectionBase<ArgsT...>::ConnectionBase(ConnectionType type)
+    : internal::ConnectionNode(type)
+{}
+
+template<typename... ArgsT>
+inline void ConnectionBase<ArgsT...>::callMove(ArgsT&&... args) const
+{
+    call(args...);
+}
+
+template<typename... ArgsT>
+inline EventLoop* ConnectionBase<ArgsT...>::eventLoop() const
+{
+    return nullptr;
+}
+
+template<typename... ArgsT>
+inline internal::SignalObjectBase* ConnectionBase<ArgsT...>::lifetimeObject() const
+{
+    return nullptr;
+}
+
+template<typename... ArgsT>
+inline void ConnectionBase<ArgsT...>::dispatch(internal::SlotArg<ArgsT>... args) const
+{
+#ifdef ZYCORE_SIGNAL_STATS
+    internal::ScopedSlotTimer timer(m_latency.get());
+#endif
+    call(args...);
+}
+
+template<typename... ArgsT>
+inline void ConnectionBase<ArgsT...>::dispatchMove(ArgsT&&... args) const
+{
+#ifdef ZYCORE_SIGNAL_STATS
+    internal::ScopedSlotTimer timer(m_latency.get());
+#endif
+    callMove(std::forward<ArgsT>(args)...);
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [FuncConnection]                                              //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline FuncConnection<ArgsT...>::FuncConnection(Function func)
+    : m_func(func)
+    , m_eventLoop(nullptr)
+{}
+
+template<typename... ArgsT>
+inline FuncConnection<ArgsT...>::FuncConnection(Function func, EventLoop* loop, 
+        ConnectionType type)
+    : ConnectionBase<ArgsT...>(type)
+    , m_func(func)
+    , m_eventLoop(loop)
+{}
+
+template<typename... ArgsT>
+inline void FuncConnection<ArgsT...>::call(internal::SlotArg<ArgsT>... args) const
+{
+    m_func(args...);
+}
+
+template<typename... ArgsT>
+inline void FuncConnection<ArgsT...>::callMove(ArgsT&&... args) const
+{
+    m_func(std::forward<ArgsT>(args)...);
+}
+
+template<typename... ArgsT>
+inline EventLoop* FuncConnection<ArgsT...>::eventLoop() const
+{
+    return m_eventLoop;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [FunctorConnection]                                           //
+// ============================================================================================== //
+
+template<typename FuncT, typename... ArgsT>
+inline FunctorConnection<FuncT, ArgsT...>::FunctorConnection(FuncT func, EventLoop* loop, 
+        ConnectionType type)
+    : ConnectionBase<ArgsT...>(type)
+    , m_func(std::move(func))
+    , m_eventLoop(loop)
+{}
+
+template<typename FuncT, typename... ArgsT>
+inline void FunctorConnection<FuncT, ArgsT...>::call(internal::SlotArg<ArgsT>... args) const
+{
+    m_func(args...);
+}
+
+template<typename FuncT, typename... ArgsT>
+inline void FunctorConnection<FuncT, ArgsT...>::callMove(ArgsT&&... args) const
+{
+    m_func(std::forward<ArgsT>(args)...);
+}
+
+template<typename FuncT, typename... ArgsT>
+inline EventLoop* FunctorConnection<FuncT, ArgsT...>::eventLoop() const
+{
+    return m_eventLoop;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [LifetimedConnection]                                         //
+// ============================================================================================== //
+
+template<typename FuncT, typename... ArgsT>
+inline LifetimedConnection<FuncT, ArgsT...>::LifetimedConnection(
+        internal::SignalObjectBase *lifetimeObj, Function func, ConnectionType type)
+    : ConnectionBase<ArgsT...>(type)
+    , m_func(std::move(func))
+    , m_lifetimeObject(lifetimeObj)
+{}
+
+template<typename FuncT, typename... ArgsT>
+inline void LifetimedConnection<FuncT, ArgsT...>::call(internal::SlotArg<ArgsT>... args) const
+{
+    m_func(args...);
+}
+
+template<typename FuncT, typename... ArgsT>
+inline void LifetimedConnection<FuncT, ArgsT...>::callMove(ArgsT&&... args) const
+{
+    m_func(std::forward<ArgsT>(args)...);
+}
+
+template<typename FuncT, typename... ArgsT>
+inline EventLoop* LifetimedConnection<FuncT, ArgsT...>::eventLoop() const
+{
+    return m_lifetimeObject ? m_lifetimeObject->eventLoop() : nullptr;
+}
+
+template<typename FuncT, typename... ArgsT>
+inline internal::SignalObjectBase* LifetimedConnection<FuncT, ArgsT...>::lifetimeObject() const
+{
+    return m_lifetimeObject;
+}
+
+// ============================================================================================== //
+// Implementation of inline functions [internal::MemberFuncBinding]                               //
+// ============================================================================================== //
+
+namespace internal
+{
+
+template<typename ObjectT, typename ResultT, typename... ArgsT>
+inline MemberFuncBinding<ObjectT, ResultT(ArgsT...)>::MemberFuncBinding(ObjectT* obj, 
+        Member memberFunc)
+    : m_obj(obj)
+    , m_member(memberFunc)
+{}
+
+template<typename ObjectT, typename ResultT, typename... ArgsT>
+template<typename... CallArgsT>
+inline ResultT MemberFuncBinding<ObjectT, ResultT(ArgsT...)>::operator() (
+    CallArgsT&&... args) const
+{
+    return (m_obj->*m_member)(std::forward<CallArgsT>(args)...);
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline functions [internal::AsyncEmission]                                   //
+// ============================================================================================== //
+
+namespace internal
+{
+
+template<typename... ArgsT>
+inline AsyncEmission<ArgsT...>::AsyncEmission(ThreadPool* pool, std::vector<ConnectionPtr> slots, 
+        SlotArg<ArgsT>... args)
+    : CompletionState(pool, slots.size())
+    , m_slots(std::move(slots))
+    , m_args(args...)
+{}
+
+template<typename... ArgsT>
+inline std::size_t AsyncEmission<ArgsT...>::numSlots() const
+{
+    return m_slots.size();
+}
+
+template<typename... ArgsT>
+inline void AsyncEmission<ArgsT...>::run(std::size_t index)
+{
+    const auto& connection = m_slots[index];
+    if (connection->isConnected())
+    {
+        applyTuple([&](auto&... args) { connection->dispatch(args...); }, m_args, 
+            std::index_sequence_for<ArgsT...>());
+    }
+    taskDone();
+}
+
+} // namespace internal
+
+// ============================================================================================== //
 // ============================================================================================== //
 // Implementation of inline functions [Signal]                                                    //
 // ============================================================================================== //
 
 template<typename... ArgsT> 
 inline Signal<ArgsT...>::Signal()
-    : m_IdCtr(1)
 {}
 
 template<typename... ArgsT>
 inline Signal<ArgsT...>::~Signal()
+{}
+
+template<typename... ArgsT>
+inline SlotHandle Signal<ArgsT...>::connect(FuncConnection<ArgsT...>* connection)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    for (auto i = m_slots.begin(); i != m_slots.end(); ++i)
-    {
-        i->second->onDestroy(i->first);
-        delete i->second;
-    }
+    return addSlot(connection);
 }
 
 template<typename... ArgsT>
-inline SlotHandle Signal<ArgsT...>::connect(FuncConnection<ArgsT...>* connection)
+inline bool Signal<ArgsT...>::disconnect(SlotHandle handle)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_slots.emplace(m_IdCtr, connection);
-    return m_IdCtr++;
+    return unlink(handle);
 }
 
 template<typename... ArgsT>
-inline bool Signal<ArgsT...>::disconnect(SlotHandle handle)
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline SlotHandle Signal<ArgsT...>::connect(FuncT&& func)
 {
+    auto connection = new FunctorConnection<std::decay_t<FuncT>, ArgsT...>(
+        std::forward<FuncT>(func));
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    auto it = m_slots.find(handle);
-    if (it == m_slots.end()) return false;
-    it->second->onDestroy(it->first);
-    delete it->second;
-    m_slots.erase(it);
-    return true;
+    return addSlot(connection);
 }
 
 template<typename... ArgsT>
-inline SlotHandle Signal<ArgsT...>::connect(typename FuncConnection<ArgsT...>::Function func)
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline SlotHandle Signal<ArgsT...>::connect(EventLoop* loop, FuncT&& func, ConnectionType type)
 {
+    assert(loop);
+    auto connection = new FunctorConnection<std::decay_t<FuncT>, ArgsT...>(
+        std::forward<FuncT>(func), loop, type);
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    auto connection = new FuncConnection<ArgsT...>(func);
-    m_slots.emplace(m_IdCtr, connection);
-    return m_IdCtr++;
+    return addSlot(connection);
 }
 
 template<typename... ArgsT>
-inline void Signal<ArgsT...>::emit(ArgsT... args) const
+inline std::size_t Signal<ArgsT...>::numSlots() const
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    for (const auto &cur : m_slots)
+    return m_numSlots;
+}
+
+template<typename... ArgsT>
+inline SlotHandle Signal<ArgsT...>::addSlot(Connection* connection)
+{
+    auto handle = link(connection, connection->lifetimeObject());
+#ifdef ZYCORE_SIGNAL_STATS
+    connection->m_latency = m_stats.onConnect(handle, connection->lifetimeObject());
+#endif
+    return handle;
+}
+
+template<typename... ArgsT>
+inline EventLoop* Signal<ArgsT...>::queueFor(const Connection& connection)
+{
+    if (connection.type() == ConnectionType::kDirect)
     {
-        cur.second->call(args...);
+        return nullptr;
     }
+
+    auto loop = connection.eventLoop();
+    if (loop && connection.type() == ConnectionType::kAuto && loop->isCurrentThread())
+    {
+        return nullptr;
+    }
+    return loop;
 }
 
 template<typename... ArgsT>
-inline void Signal<ArgsT...>::operator()(ArgsT... args) const
+inline void Signal<ArgsT...>::postQueued(EventLoop* loop, Connection* connection, 
+    std::shared_ptr<ArgsTuple>& queuedArgs, internal::SlotArg<ArgsT>... args)
 {
-    emit(args...);
+    if (!queuedArgs)
+    {
+        queuedArgs = std::make_shared<ArgsTuple>(args...);
+    }
+
+    loop->post([connection = ConnectionPtr(connection), queuedArgs]
+    {
+        if (connection->isConnected())
+        {
+            internal::applyTuple([&](auto&... queued) { connection->dispatch(queued...); }, 
+                *queuedArgs, std::index_sequence_for<ArgsT...>());
+        }
+    });
 }
 
 template<typename... ArgsT>
-inline Signal<ArgsT...>& Signal<ArgsT...>::operator += (
-    typename FuncConnection<ArgsT...>::Function func)
+inline void Signal<ArgsT...>::emit(internal::SlotArg<ArgsT>... args) const
 {
-    connect(func);
-    return *this;
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    EmitScope scope(*this);
+#ifdef ZYCORE_SIGNAL_STATS
+    m_stats.onEmit();
+#endif
+    std::shared_ptr<ArgsTuple> queuedArgs;
+    for (auto node = firstSlot(); node; node = nextSlot(node))
+    {
+        auto connection = static_cast<Connection*>(node);
+        auto loop = queueFor(*connection);
+        if (loop)
+        {
+            postQueued(loop, connection, queuedArgs, args...);
+        }
+        else
+        {
+            connection->dispatch(args...);
+        }
+    }
 }
 
 template<typename... ArgsT>
-inline void Signal<ArgsT...>::onSlotsObjectDestroyed(SlotHandle handle)
+inline void Signal<ArgsT...>::emitMove(ArgsT... args) const
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    for (auto i = m_slots.begin(); i != m_slots.end();)
+    EmitScope scope(*this);
+#ifdef ZYCORE_SIGNAL_STATS
+    m_stats.onEmit();
+#endif
+    std::shared_ptr<ArgsTuple> queuedArgs;
+    // Slots may disconnect later ones, so the next slot is only looked up after the call. The
+    // arguments are moved into the last slot still connected at the time it is called.
+    for (auto node = firstSlot(); node; node = nextSlot(node))
     {
-        if (i->first == handle)
+        auto connection = static_cast<Connection*>(node);
+        auto loop = queueFor(*connection);
+        if (loop)
         {
-            delete i->second;
-            i = m_slots.erase(i);
+            postQueued(loop, connection, queuedArgs, args...);
+        }
+        else if (!nextSlot(node))
+        {
+            connection->dispatchMove(std::forward<ArgsT>(args)...);
         }
         else
         {
-            ++i;
+            connection->dispatch(args...);
+        }
+    }
+}
+
+template<typename... ArgsT>
+inline bool Signal<ArgsT...>::emitTo(SlotHandle handle, internal::SlotArg<ArgsT>... args) const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    auto node = lookup(handle);
+    if (!node)
+    {
+        return false;
+    }
+
+    EmitScope scope(*this);
+    auto connection = static_cast<Connection*>(node);
+    auto loop = queueFor(*connection);
+    if (loop)
+    {
+        std::shared_ptr<ArgsTuple> queuedArgs;
+        postQueued(loop, connection, queuedArgs, args...);
+    }
+    else
+    {
+        connection->dispatch(args...);
+    }
+    return true;
+}
+
+template<typename... ArgsT>
+inline Completion Signal<ArgsT...>::emitAsync(ThreadPool& pool, 
+    internal::SlotArg<ArgsT>... args) const
+{
+    std::vector<ConnectionPtr> slots;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+#ifdef ZYCORE_SIGNAL_STATS
+        m_stats.onEmit();
+#endif
+        std::shared_ptr<ArgsTuple> queuedArgs;
+        slots.reserve(m_numSlots);
+        for (auto node = firstSlot(); node; node = nextSlot(node))
+        {
+            auto connection = static_cast<Connection*>(node);
+            auto loop = queueFor(*connection);
+            if (loop)
+            {
+                postQueued(loop, connection, queuedArgs, args...);
+            }
+            else if (isAwaitHub(node))
+            {
+                // Only hands the waiters to their executors, not worth a task of its own.
+                connection->dispatch(args...);
+            }
+            else
+            {
+                slots.emplace_back(connection);
+            }
         }
     }
+
+    if (slots.empty())
+    {
+        return Completion();
+    }
+
+    auto emission = std::make_shared<internal::AsyncEmission<ArgsT...>>(
+        &pool, std::move(slots), args...);
+    emission->keepAlive(emission);
+
+    // The tasks only capture a raw pointer and an index: small enough to not allocate.
+    auto rawEmission = emission.get();
+    for (std::size_t i = 0, n = emission->numSlots(); i < n; ++i)
+    {
+        pool.submit([rawEmission, i] { rawEmission->run(i); });
+    }
+
+    return Completion(std::move(emission));
+}
+
+template<typename... ArgsT>
+inline Completion Signal<ArgsT...>::emitAsync(internal::SlotArg<ArgsT>... args) const
+{
+    return emitAsync(ThreadPool::global(), args...);
+}
+
+template<typename... ArgsT>
+inline void Signal<ArgsT...>::operator()(internal::SlotArg<ArgsT>... args) const
+{
+    emit(args...);
+}
+
+template<typename... ArgsT>
+template<typename FuncT, std::enable_if_t<internal::IsSlot<FuncT, ArgsT...>::value, int>>
+inline Signal<ArgsT...>& Signal<ArgsT...>::operator += (FuncT&& func)
+{
+    connect(std::forward<FuncT>(func));
+    return *this;
+}
+
+#ifdef ZYCORE_SIGNAL_STATS
+template<typename... ArgsT>
+inline SignalStats& Signal<ArgsT...>::stats()
+{
+    return m_stats;
 }
+#endif
 
 // ============================================================================================== //
 
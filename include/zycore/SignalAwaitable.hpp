@@ -0,0 +1,394 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_SIGNALAWAITABLE_HPP
+#define ZYCORE_SIGNALAWAITABLE_HPP
+
+#include "zycore/Optional.hpp"
+#include "zycore/SignalObject.hpp"
+#include "zycore/ThreadPool.hpp"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <tuple>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// Internal helpers                                                                               //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Intrusive list of coroutines awaiting a signal.
+     */
+    template<typename WaiterT>
+    struct AwaitList
+    {
+        WaiterT* head = nullptr;
+        WaiterT* tail = nullptr;
+
+        void pushBack(WaiterT* waiter);
+        WaiterT* popFront();
+        void remove(WaiterT* waiter);
+        void takeFrom(AwaitList& other);
+    };
+
+    /**
+     * @brief   Connection resuming the coroutines awaiting a signal.
+     *          
+     * Created the first time a signal is awaited, one per lifetime object, and kept connected 
+     * afterwards, so awaiting doesn't allocate once warmed up. Hubs aren't counted as slots by
+     * the signal and don't show up in its statistics. When the connection is loosened, because
+     * either the signal or the lifetime object is destroyed, the waiters are resumed without a 
+     * result.
+     */
+    template<typename... ArgsT>
+    class AwaitHub : public ConnectionBase<ArgsT...>
+    {
+        friend class Signal<ArgsT...>;
+        friend class SignalAwaitable<ArgsT...>;
+        using Waiter = SignalAwaitable<ArgsT...>;
+    private:
+        SignalObjectBase* m_object;
+        ConnectionNode* m_nextHub;
+        // Guarded by the signal's mutex.
+        mutable AwaitList<Waiter> m_waiters;
+    public:
+        /**
+         * @brief   Constructor.
+         * @param   object  The lifetime object, may be @c nullptr.
+         */
+        explicit AwaitHub(SignalObjectBase* object);
+
+        void call(internal::SlotArg<ArgsT>... args) const override;
+        SignalObjectBase* lifetimeObject() const override;
+    private:
+        void onDisconnected() override;
+    };
+} // namespace internal
+
+// ============================================================================================== //
+// [SignalAwaitable]                                                                              //
+// ============================================================================================== //
+
+/**
+ * @brief   Awaitable resuming a coroutine with the arguments of a signal's next emission.
+ *          
+ * Obtained from @c Signal::next. The coroutine is registered with the signal when it suspends,
+ * the first emission after that resumes it, by default on the emitting thread, from inside 
+ * @c emit. Passing an event loop or thread pool to @c Signal::next hands the resumption to it
+ * instead.
+ * 
+ * @c co_await yields an empty result if the wait was cancelled because the signal or the 
+ * lifetime object passed to @c Signal::next was destroyed. Waiters without an executor are 
+ * resumed from within that destruction.
+ * 
+ * The waiter lives in the coroutine frame, awaiting doesn't allocate beyond the first wait per
+ * signal and lifetime object. Posting to an executor may allocate, depending on the executor.
+ */
+template<typename... ArgsT>
+class SignalAwaitable : public NonCopyable
+{
+    friend class Signal<ArgsT...>;
+    friend class internal::AwaitHub<ArgsT...>;
+    friend struct internal::AwaitList<SignalAwaitable>;
+public:
+    using Result = Optional<std::tuple<std::decay_t<ArgsT>...>>;
+private:
+    using Hub = internal::AwaitHub<ArgsT...>;
+    using Schedule = void (*)(void* executor, std::coroutine_handle<> coroutine);
+
+    internal::IntrusivePtr<Hub> m_hub;
+    std::coroutine_handle<> m_coroutine;
+    void* m_executor;
+    Schedule m_schedule;
+    Result m_result;
+    // Guarded by the signal's mutex.
+    internal::AwaitList<SignalAwaitable>* m_list;
+    SignalAwaitable* m_prev;
+    SignalAwaitable* m_next;
+private:
+    SignalAwaitable(internal::IntrusivePtr<Hub> hub, void* executor, Schedule schedule);
+public: // Destructor.
+    /**
+     * @brief   Destructor. Unregisters the coroutine if it is destroyed while suspended.
+     */
+    ~SignalAwaitable();
+public: // Awaitable interface.
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> coroutine);
+    Result await_resume();
+private:
+    static void postToLoop(void* loop, std::coroutine_handle<> coroutine);
+    static void submitToPool(void* pool, std::coroutine_handle<> coroutine);
+
+    /**
+     * @brief   Resumes the coroutine through the executor.
+     * @remarks The instance may be destroyed when this returns.
+     */
+    void resume();
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::AwaitList]                                         //
+// ============================================================================================== //
+
+namespace internal
+{
+
+template<typename WaiterT>
+inline void AwaitList<WaiterT>::pushBack(WaiterT* waiter)
+{
+    waiter->m_list = this;
+    waiter->m_prev = tail;
+    waiter->m_next = nullptr;
+    (tail ? tail->m_next : head) = waiter;
+    tail = waiter;
+}
+
+template<typename WaiterT>
+inline WaiterT* AwaitList<WaiterT>::popFront()
+{
+    auto waiter = head;
+    if (waiter)
+    {
+        remove(waiter);
+    }
+    return waiter;
+}
+
+template<typename WaiterT>
+inline void AwaitList<WaiterT>::remove(WaiterT* waiter)
+{
+    (waiter->m_prev ? waiter->m_prev->m_next : head) = waiter->m_next;
+    (waiter->m_next ? waiter->m_next->m_prev : tail) = waiter->m_prev;
+    waiter->m_list = nullptr;
+}
+
+template<typename WaiterT>
+inline void AwaitList<WaiterT>::takeFrom(AwaitList& other)
+{
+    head = other.head;
+    tail = other.tail;
+    other.head = other.tail = nullptr;
+    for (auto waiter = head; waiter; waiter = waiter->m_next)
+    {
+        waiter->m_list = this;
+    }
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::AwaitHub]                                          //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline AwaitHub<ArgsT...>::AwaitHub(SignalObjectBase* object)
+    : m_object(object)
+    , m_nextHub(nullptr)
+{
+    this->m_awaitHub = true;
+}
+
+template<typename... ArgsT>
+inline void AwaitHub<ArgsT...>::call(internal::SlotArg<ArgsT>... args) const
+{
+    // Coroutines awaiting again while being resumed wait for the next emission.
+    AwaitList<Waiter> batch;
+    batch.takeFrom(m_waiters);
+    while (auto waiter = batch.popFront())
+    {
+        waiter->m_result = std::tuple<std::decay_t<ArgsT>...>(args...);
+        waiter->resume();
+    }
+}
+
+template<typename... ArgsT>
+inline SignalObjectBase* AwaitHub<ArgsT...>::lifetimeObject() const
+{
+    return m_object;
+}
+
+template<typename... ArgsT>
+inline void AwaitHub<ArgsT...>::onDisconnected()
+{
+    auto link = &this->m_signal->m_awaitHubs;
+    while (*link != this)
+    {
+        link = &static_cast<AwaitHub*>(*link)->m_nextHub;
+    }
+    *link = m_nextHub;
+
+    AwaitList<Waiter> batch;
+    batch.takeFrom(m_waiters);
+    while (auto waiter = batch.popFront())
+    {
+        waiter->resume();
+    }
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [SignalAwaitable]                                             //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline SignalAwaitable<ArgsT...>::SignalAwaitable(internal::IntrusivePtr<Hub> hub, 
+    void* executor, Schedule schedule)
+    : m_hub(std::move(hub))
+    , m_executor(executor)
+    , m_schedule(schedule)
+    , m_list(nullptr)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+{}
+
+template<typename... ArgsT>
+inline SignalAwaitable<ArgsT...>::~SignalAwaitable()
+{
+    // Resumed waiters were unregistered by the resuming thread, which happened before the 
+    // resumption. Only coroutines destroyed while suspended have to take the lock.
+    if (!m_list)
+    {
+        return;
+    }
+
+    auto lock = m_hub->lockSignal();
+    if (lock.owns_lock() && m_list)
+    {
+        m_list->remove(this);
+    }
+}
+
+template<typename... ArgsT>
+inline bool SignalAwaitable<ArgsT...>::await_ready() const noexcept
+{
+    return false;
+}
+
+template<typename... ArgsT>
+inline bool SignalAwaitable<ArgsT...>::await_suspend(std::coroutine_handle<> coroutine)
+{
+    m_coroutine = coroutine;
+    auto lock = m_hub->lockSignal();
+    if (!lock.owns_lock())
+    {
+        // Already cancelled, continue right away without a result.
+        return false;
+    }
+
+    // Once the lock is released, the coroutine may be resumed and this instance be gone.
+    m_hub->m_waiters.pushBack(this);
+    return true;
+}
+
+template<typename... ArgsT>
+inline typename SignalAwaitable<ArgsT...>::Result SignalAwaitable<ArgsT...>::await_resume()
+{
+    return std::move(m_result);
+}
+
+template<typename... ArgsT>
+inline void SignalAwaitable<ArgsT...>::postToLoop(void* loop, std::coroutine_handle<> coroutine)
+{
+    static_cast<EventLoop*>(loop)->post([coroutine] { coroutine.resume(); });
+}
+
+template<typename... ArgsT>
+inline void SignalAwaitable<ArgsT...>::submitToPool(void* pool, std::coroutine_handle<> coroutine)
+{
+    static_cast<ThreadPool*>(pool)->submit([coroutine] { coroutine.resume(); });
+}
+
+template<typename... ArgsT>
+inline void SignalAwaitable<ArgsT...>::resume()
+{
+    if (m_schedule)
+    {
+        m_schedule(m_executor, m_coroutine);
+    }
+    else
+    {
+        m_coroutine.resume();
+    }
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [Signal]                                                      //
+// ============================================================================================== //
+
+template<typename... ArgsT>
+inline SignalAwaitable<ArgsT...> Signal<ArgsT...>::next(SignalObject* lifetimeObject)
+{
+    return SignalAwaitable<ArgsT...>(awaitHub(lifetimeObject), nullptr, nullptr);
+}
+
+template<typename... ArgsT>
+inline SignalAwaitable<ArgsT...> Signal<ArgsT...>::next(EventLoop& loop, 
+    SignalObject* lifetimeObject)
+{
+    return SignalAwaitable<ArgsT...>(awaitHub(lifetimeObject), &loop, 
+        &SignalAwaitable<ArgsT...>::postToLoop);
+}
+
+template<typename... ArgsT>
+inline SignalAwaitable<ArgsT...> Signal<ArgsT...>::next(ThreadPool& pool, 
+    SignalObject* lifetimeObject)
+{
+    return SignalAwaitable<ArgsT...>(awaitHub(lifetimeObject), &pool, 
+        &SignalAwaitable<ArgsT...>::submitToPool);
+}
+
+template<typename... ArgsT>
+inline internal::IntrusivePtr<internal::AwaitHub<ArgsT...>> Signal<ArgsT...>::awaitHub(
+    SignalObject* lifetimeObject)
+{
+    using Hub = internal::AwaitHub<ArgsT...>;
+    internal::SignalObjectBase* object = lifetimeObject;
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    auto hub = static_cast<Hub*>(m_awaitHubs);
+    while (hub && hub->m_object != object)
+    {
+        hub = static_cast<Hub*>(hub->m_nextHub);
+    }
+    if (!hub)
+    {
+        hub = new Hub(object);
+        link(hub, object);
+        hub->m_nextHub = m_awaitHubs;
+        m_awaitHubs = hub;
+    }
+    return internal::IntrusivePtr<Hub>(hub);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // __cpp_impl_coroutine
+
+#endif // ZYCORE_SIGNALAWAITABLE_HPP
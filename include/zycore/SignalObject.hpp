@@ -30,9 +30,7 @@
 
 #include "zycore/Signal.hpp"
 
-#include <vector>
-#include <mutex>
-#include <memory>
+#include <atomic>
 
 namespace zycore
 {
@@ -50,17 +48,35 @@ class SignalObject
     : public internal::SignalObjectBase
     , public NonCopyable
 {
-    std::recursive_mutex m_objectMutex;
-    std::vector<std::tuple<SlotHandle, internal::SignalBase*>> m_connectedSignals;
+    internal::LoopAffinity m_affinity;
 public: // Con- and destruction.
     /**
      * @brief   Default constructor.
+     *          
+     * The object has affinity to the event loop of the constructing thread, if any.
      */
-    SignalObject() = default;
+    SignalObject();
     /**
      * @brief   Destructor.
      */
     virtual ~SignalObject();
+public: // Thread affinity.
+    /**
+     * @brief   Gets the event loop queued slot calls to this object are delivered to.
+     * @return  The event loop or @c nullptr if the object has no thread affinity, which is also
+     *          the case once the loop has been destroyed.
+     * @remarks This routine is thread-safe.
+     */
+    EventLoop* eventLoop() const override;
+    /**
+     * @brief   Changes the thread affinity of this object.
+     * @param   loop    The event loop to deliver queued slot calls to. @c nullptr makes all
+     *                  calls direct.
+     * @remarks This routine is thread-safe, but must not race with the destruction of the 
+     *          previous event loop. Calls that are already queued are still delivered to the 
+     *          previous event loop.
+     */
+    void setEventLoop(EventLoop* loop);
 public: // Signals.
     /**
      * @brief   Signal emitted after object destruction, prior the destruction
@@ -70,20 +86,10 @@ public: // Signals.
 private:
     /**
      * @brief   Destroys this object and disconnects the slots from all signals.
+     *          
+     * Takes constant time per connection, independent of the number of slots the signals have.
      */
     void destroy();
-    /**
-     * @brief   Called when a signal is disconnected from one of our slots.
-     * @param   signal The signal we are connected to.
-     * @param   handle The slot handle which has been assigned to the object.
-     */
-    void onSignalConnected(internal::SignalBase* signal, SlotHandle handle) override;
-    /**
-     * @brief   Called when a signal is disconnected from one of our slots.
-     * @param   signal The signal to disconnect from.
-     * @param   handle The slot handle of the connection to be removed.
-     */
-    void onSignalDisconnected(internal::SignalBase* signal, SlotHandle handle) override;
 };
 
 // ============================================================================================== //
@@ -0,0 +1,535 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_SIGNALRECORDER_HPP
+#define ZYCORE_SIGNALRECORDER_HPP
+
+#ifdef ZYCORE_HEADER_ONLY
+#   error "This file cannot be used in header-only mode."
+#endif // ZYCORE_HEADER_ONLY
+
+#include "zycore/BinaryStream.hpp"
+#include "zycore/Exceptions.hpp"
+#include "zycore/Signal.hpp"
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [SignalTraceCodec]                                                                             //
+// ============================================================================================== //
+
+/**
+ * @brief   Encodes and decodes signal arguments of type @c T for emission traces.
+ * @tparam  T   The decayed argument type.
+ *
+ * Trivially copyable types, @c std::string and @c std::vector of encodable types are supported
+ * out of the box. Other argument types require a specialization providing static @c write and
+ * @c read functions with the signatures used below.
+ */
+template<typename T, typename EnableT = void>
+struct SignalTraceCodec
+{
+    static_assert(BlackBoxConsts<T>::kFalse,
+        "no SignalTraceCodec specialization found for given argument type");
+};
+
+namespace internal
+{
+    /**
+     * @brief   Appends raw bytes at the write position of a stream.
+     *
+     * Trace records are packed, so values are copied bytewise rather than through the typed
+     * stream operators, which would access them misaligned.
+     */
+    inline void traceWrite(OBinaryStream& stream, const void* src, std::size_t len)
+    {
+        stream.rawWrite(stream.wpos(), len, static_cast<const uint8_t*>(src));
+        stream.wpos(stream.wpos() + len);
+    }
+
+    /**
+     * @brief   Consumes raw bytes at the read position of a stream.
+     */
+    inline void traceRead(IBinaryStream& stream, void* dst, std::size_t len)
+    {
+        stream.rawRead(stream.rpos(), len, static_cast<uint8_t*>(dst));
+        stream.rpos(stream.rpos() + len);
+    }
+} // namespace internal
+
+/**
+ * @brief   Codec for trivially copyable types. Pointers are rejected, as their values are
+ *          meaningless in a replaying process.
+ */
+template<typename T>
+struct SignalTraceCodec<T, typename std::enable_if<
+    std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>::type>
+{
+    static void write(OBinaryStream& stream, const T& value)
+    {
+        internal::traceWrite(stream, &value, sizeof(T));
+    }
+
+    static void read(IBinaryStream& stream, T& value)
+    {
+        internal::traceRead(stream, &value, sizeof(T));
+    }
+};
+
+/**
+ * @brief   Codec for strings, stored as 64 bit length followed by the characters.
+ */
+template<>
+struct SignalTraceCodec<std::string>
+{
+    static void write(OBinaryStream& stream, const std::string& value)
+    {
+        uint64_t len = value.size();
+        internal::traceWrite(stream, &len, sizeof(len));
+        internal::traceWrite(stream, value.data(), value.size());
+    }
+
+    static void read(IBinaryStream& stream, std::string& value)
+    {
+        uint64_t len;
+        internal::traceRead(stream, &len, sizeof(len));
+        if (len > stream.size() - stream.rpos())
+        {
+            ZYCORE_RAISE(OutOfBounds, "string length exceeds the trace");
+        }
+        value.resize(static_cast<std::size_t>(len));
+        internal::traceRead(stream, &value[0], value.size());
+    }
+};
+
+/**
+ * @brief   Codec for vectors, stored as 64 bit element count followed by the elements.
+ */
+template<typename T>
+struct SignalTraceCodec<std::vector<T>>
+{
+    static void write(OBinaryStream& stream, const std::vector<T>& value)
+    {
+        uint64_t len = value.size();
+        internal::traceWrite(stream, &len, sizeof(len));
+        for (const auto& curElement : value)
+        {
+            SignalTraceCodec<T>::write(stream, curElement);
+        }
+    }
+
+    static void read(IBinaryStream& stream, std::vector<T>& value)
+    {
+        uint64_t len;
+        internal::traceRead(stream, &len, sizeof(len));
+        if (len > stream.size() - stream.rpos())
+        {
+            ZYCORE_RAISE(OutOfBounds, "vector length exceeds the trace");
+        }
+        value.resize(static_cast<std::size_t>(len));
+        for (auto& curElement : value)
+        {
+            SignalTraceCodec<T>::read(stream, curElement);
+        }
+    }
+};
+
+// ============================================================================================== //
+// [SignalTrace]                                                                                  //
+// ============================================================================================== //
+
+/**
+ * @brief   Layout constants of emission traces.
+ *
+ * A trace starts with @c kMagic and @c kVersion (32 bit each), followed by one record per
+ * emission: the 32 bit channel, the 64 bit timestamp in nanoseconds since recording started,
+ * the 32 bit payload size and the payload, i.e. the encoded arguments. The payload size allows
+ * replayers to skip channels they have no signal bound to.
+ */
+struct SignalTrace
+{
+    static const uint32_t kMagic   = 0x5254595A; // "ZYTR"
+    static const uint32_t kVersion = 1;
+};
+
+// ============================================================================================== //
+// [SignalRecorder]                                                                               //
+// ============================================================================================== //
+
+/**
+ * @brief   Records the emissions of selected signals into a binary trace.
+ *
+ * Every signal passed to @c record gets its own channel in the trace and a slot connected that
+ * serializes the emitted arguments together with a timestamp. Emissions from different threads
+ * are serialized into the stream in the order they reach the recorder, so timestamps within a
+ * trace never decrease. The recorder slot is a direct connection appended to the signal, it
+ * observes each emission after the slots connected before it.
+ *
+ * The stream must outlive the recorder or the call to @c stop.
+ */
+class SignalRecorder : public NonCopyable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+private:
+    mutable std::mutex m_mutex;
+    OBinaryStream& m_stream;
+    Clock::time_point m_start;
+    std::vector<ScopedConnection> m_connections;
+    std::size_t m_numRecorded;
+    uint32_t m_numChannels;
+private:
+    /**
+     * @brief   Appends a record to the trace.
+     */
+    template<typename... ArgsT>
+    void write(uint32_t channel, const ArgsT&... args);
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor. Writes the trace header to @c stream.
+     * @param   stream  The stream to record into.
+     */
+    explicit SignalRecorder(OBinaryStream& stream);
+
+    /**
+     * @brief   Destructor. Stops recording.
+     */
+    ~SignalRecorder();
+public: // Public interface.
+    /**
+     * @brief   Starts recording the emissions of a signal.
+     * @param   signal  The signal to record. All argument types need a @c SignalTraceCodec.
+     * @return  The channel the signal's emissions are recorded to, to be passed to
+     *          @c SignalReplayer::bind. Channels are numbered in order of calls to this method.
+     */
+    template<typename... ArgsT>
+    uint32_t record(Signal<ArgsT...>& signal);
+
+    /**
+     * @brief   Disconnects from all recorded signals.
+     *
+     * When this method returns, no emission is being recorded anymore.
+     */
+    void stop();
+
+    /**
+     * @brief   Gets the number of emissions recorded so far.
+     * @return  The number of records.
+     * @remarks This routine is thread-safe.
+     */
+    std::size_t numRecorded() const;
+};
+
+// ============================================================================================== //
+// [SignalReplayer]                                                                               //
+// ============================================================================================== //
+
+/**
+ * @brief   Re-emits the emissions stored in a trace written by @c SignalRecorder.
+ *
+ * Signals are bound to the channels they should receive. Records of unbound channels are
+ * skipped. Replaying emits from the calling thread, either as fast as possible, which turns
+ * recorded traffic into a repeatable benchmark for the connected slots, or paced to reproduce the
+ * recorded timing.
+ */
+class SignalReplayer : public NonCopyable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+private:
+    using Channel = std::function<void(IBinaryStream&)>;
+private:
+    IBinaryStream& m_stream;
+    IBinaryStream::StreamOffs m_begin;
+    std::vector<Channel> m_channels;
+private:
+    /**
+     * @brief   Replays the next record.
+     * @param   pacingStart The point in time the trace's zero timestamp maps to.
+     * @param   speed       The pacing speed factor or 0 to emit without delay.
+     * @return  @c false if the end of the trace has been reached, else @c true.
+     */
+    bool replayNext(Clock::time_point pacingStart, double speed);
+
+    /**
+     * @brief   Decodes a payload and emits it.
+     */
+    template<typename... ArgsT, std::size_t... IndicesT>
+    static void emitDecoded(Signal<ArgsT...>& signal, IBinaryStream& stream, 
+        std::index_sequence<IndicesT...>);
+public: // Constructor.
+    /**
+     * @brief   Constructor. Reads and validates the trace header.
+     * @param   stream  The stream to replay from, positioned at the start of the trace.
+     * @throws  InvalidUsage if the stream holds no trace of a supported version.
+     */
+    explicit SignalReplayer(IBinaryStream& stream);
+public: // Public interface.
+    /**
+     * @brief   Binds a signal to a channel of the trace.
+     * @param   channel The channel, as returned by @c SignalRecorder::record.
+     * @param   signal  The signal to emit the channel's records on. Its argument types must be
+     *                  the ones of the recorded signal, decoded arguments have to be default
+     *                  constructible.
+     *
+     * The signal must outlive all replay calls.
+     */
+    template<typename... ArgsT>
+    void bind(uint32_t channel, Signal<ArgsT...>& signal);
+
+    /**
+     * @brief   Replays the next record without delay.
+     * @return  @c false if the end of the trace has been reached, else @c true.
+     */
+    bool step();
+
+    /**
+     * @brief   Replays all remaining records.
+     * @param   speed   0 to emit as fast as possible, else the factor the recorded timing is
+     *                  sped up by, i.e. 1 reproduces the original pacing.
+     * @return  The number of records replayed, including skipped ones.
+     */
+    std::size_t replay(double speed = 0);
+
+    /**
+     * @brief   Rewinds to the first record.
+     */
+    void rewind();
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [SignalRecorder]                                              //
+// ============================================================================================== //
+
+inline SignalRecorder::SignalRecorder(OBinaryStream& stream)
+    : m_stream(stream)
+    , m_start(Clock::now())
+    , m_numRecorded(0)
+    , m_numChannels(0)
+{
+    uint32_t header[] = {SignalTrace::kMagic, SignalTrace::kVersion};
+    internal::traceWrite(m_stream, header, sizeof(header));
+}
+
+inline SignalRecorder::~SignalRecorder()
+{
+    stop();
+}
+
+template<typename... ArgsT>
+inline void SignalRecorder::write(uint32_t channel, const ArgsT&... args)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Taking the timestamp under the lock keeps them ordered within the trace.
+    auto timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - m_start).count());
+    uint32_t payloadSize = 0;
+    internal::traceWrite(m_stream, &channel, sizeof(channel));
+    internal::traceWrite(m_stream, &timestamp, sizeof(timestamp));
+    auto sizePos = m_stream.wpos();
+    internal::traceWrite(m_stream, &payloadSize, sizeof(payloadSize));
+
+    using Expand = int[];
+    (void)Expand{0, (SignalTraceCodec<ArgsT>::write(m_stream, args), 0)...};
+
+    payloadSize = static_cast<uint32_t>(m_stream.wpos() - sizePos - sizeof(payloadSize));
+    m_stream.rawWrite(sizePos, sizeof(payloadSize), reinterpret_cast<uint8_t*>(&payloadSize));
+    ++m_numRecorded;
+}
+
+template<typename... ArgsT>
+inline uint32_t SignalRecorder::record(Signal<ArgsT...>& signal)
+{
+    uint32_t channel;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        channel = m_numChannels++;
+    }
+
+    // Connecting takes the signal's lock, which emissions hold while they call into the recorder,
+    // so our own lock must not be held here.
+    auto connection = signal.makeScoped(signal.connect(
+        [this, channel](const typename std::decay<ArgsT>::type&... args)
+        {
+            write(channel, args...);
+        }));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_connections.emplace_back(std::move(connection));
+    return channel;
+}
+
+inline void SignalRecorder::stop()
+{
+    std::vector<ScopedConnection> connections;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        connections.swap(m_connections);
+    }
+
+    // Disconnecting waits for running emissions of the signal, see above.
+    connections.clear();
+}
+
+inline std::size_t SignalRecorder::numRecorded() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numRecorded;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [SignalReplayer]                                              //
+// ============================================================================================== //
+
+inline SignalReplayer::SignalReplayer(IBinaryStream& stream)
+    : m_stream(stream)
+{
+    uint32_t header[2];
+    if (m_stream.size() - m_stream.rpos() < sizeof(header))
+    {
+        ZYCORE_RAISE(InvalidUsage, "stream holds no signal trace");
+    }
+    internal::traceRead(m_stream, header, sizeof(header));
+    if (header[0] != SignalTrace::kMagic)
+    {
+        ZYCORE_RAISE(InvalidUsage, "stream holds no signal trace");
+    }
+    if (header[1] != SignalTrace::kVersion)
+    {
+        ZYCORE_RAISE(InvalidUsage, "unsupported signal trace version");
+    }
+    m_begin = m_stream.rpos();
+}
+
+template<typename... ArgsT, std::size_t... IndicesT>
+inline void SignalReplayer::emitDecoded(Signal<ArgsT...>& signal, IBinaryStream& stream, 
+    std::index_sequence<IndicesT...>)
+{
+    std::tuple<typename std::decay<ArgsT>::type...> args;
+    using Expand = int[];
+    (void)Expand{0, (SignalTraceCodec<typename std::decay<ArgsT>::type>::read(
+        stream, std::get<IndicesT>(args)), 0)...};
+    signal.emit(std::get<IndicesT>(args)...);
+}
+
+template<typename... ArgsT>
+inline void SignalReplayer::bind(uint32_t channel, Signal<ArgsT...>& signal)
+{
+    if (channel >= m_channels.size())
+    {
+        m_channels.resize(channel + 1);
+    }
+    m_channels[channel] = [&signal](IBinaryStream& stream)
+    {
+        emitDecoded(signal, stream, std::index_sequence_for<ArgsT...>());
+    };
+}
+
+inline bool SignalReplayer::replayNext(Clock::time_point pacingStart, double speed)
+{
+    uint32_t channel;
+    uint64_t timestamp;
+    uint32_t payloadSize;
+    if (m_stream.rpos() >= m_stream.size())
+    {
+        return false;
+    }
+    internal::traceRead(m_stream, &channel, sizeof(channel));
+    internal::traceRead(m_stream, &timestamp, sizeof(timestamp));
+    internal::traceRead(m_stream, &payloadSize, sizeof(payloadSize));
+    auto payloadEnd = m_stream.rpos() + payloadSize;
+    if (payloadEnd > m_stream.size())
+    {
+        ZYCORE_RAISE(OutOfBounds, "truncated signal trace record");
+    }
+
+    if (channel >= m_channels.size() || !m_channels[channel])
+    {
+        m_stream.rpos(payloadEnd);
+        return true;
+    }
+
+    if (speed > 0)
+    {
+        std::this_thread::sleep_until(pacingStart + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::nano>(static_cast<double>(timestamp) / speed)));
+    }
+
+    // Resync to the recorded size, so a codec consuming too little or too much corrupts only
+    // its own record.
+    m_channels[channel](m_stream);
+    m_stream.rpos(payloadEnd);
+    return true;
+}
+
+inline bool SignalReplayer::step()
+{
+    return replayNext(Clock::time_point(), 0);
+}
+
+inline std::size_t SignalReplayer::replay(double speed)
+{
+    std::size_t numReplayed = 0;
+    auto pacingStart = Clock::now();
+    bool first = true;
+    while (m_stream.rpos() < m_stream.size())
+    {
+        // Pacing is relative to the first remaining record, so replay starts without delay.
+        if (first && speed > 0)
+        {
+            uint64_t firstTimestamp;
+            m_stream.rawRead(m_stream.rpos() + sizeof(uint32_t), sizeof(firstTimestamp), 
+                reinterpret_cast<uint8_t*>(&firstTimestamp));
+            pacingStart -= std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::nano>(
+                    static_cast<double>(firstTimestamp) / speed));
+        }
+        first = false;
+        replayNext(pacingStart, speed);
+        ++numReplayed;
+    }
+    return numReplayed;
+}
+
+inline void SignalReplayer::rewind()
+{
+    m_stream.rpos(m_begin);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_SIGNALRECORDER_HPP
@@ -0,0 +1,640 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ZYCORE_SIGNALSTATS_HPP
+#define ZYCORE_SIGNALSTATS_HPP
+
+#include "zycore/Config.hpp"
+#include "zycore/Utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(ZYCORE_MSVC)
+#   include <intrin.h>
+#endif
+
+namespace zycore
+{
+
+/**
+ * @defgroup sigstats Signal instrumentation
+ *
+ * Emit counters and per-slot latency histograms for @c Signal, compiled in by defining
+ * @c ZYCORE_SIGNAL_STATS (CMake option of the same name). Without it, signals carry no
+ * instrumentation state and emitting them does not touch a single counter.
+ */
+
+// ============================================================================================== //
+// [LatencyHistogram]                                                                             //
+// ============================================================================================== //
+
+/**
+ * @brief   Lock-free log-linear histogram of durations in nanoseconds.
+ * @ingroup sigstats
+ *
+ * Every power of two is split into @c kSubBuckets linear buckets, so the relative error of a
+ * recorded value is below 1 / @c kSubBuckets regardless of its magnitude. Values smaller than
+ * @c kSubBuckets get exact buckets, values of 2 ^ @c kMaxBits ns (about 18 minutes) and above are
+ * clamped into the last one. Recording is a handful of relaxed atomic increments and may happen
+ * concurrently from any number of threads.
+ */
+class LatencyHistogram : public NonCopyable
+{
+public:
+    static const unsigned kSubBucketBits = 3;
+    static const unsigned kSubBuckets = 1 << kSubBucketBits;
+    static const unsigned kMaxBits = 40;
+    static const unsigned kNumBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+    /**
+     * @brief   Point-in-time copy of a histogram.
+     */
+    struct Snapshot
+    {
+        std::uint64_t count = 0;
+        std::uint64_t sumNs = 0;
+        std::uint64_t maxNs = 0;
+        std::vector<std::uint64_t> buckets;
+
+        /**
+         * @brief   Gets the mean of the recorded values.
+         * @return  The mean in nanoseconds, @c 0 if nothing was recorded.
+         */
+        std::uint64_t meanNs() const;
+
+        /**
+         * @brief   Gets an upper bound of the given percentile.
+         * @param   percentile  The percentile, in the range [0, 100].
+         * @return  The upper bound of the bucket containing the percentile, in nanoseconds.
+         */
+        std::uint64_t percentileNs(double percentile) const;
+    };
+private:
+    std::atomic<std::uint64_t> m_buckets[kNumBuckets];
+    std::atomic<std::uint64_t> m_count;
+    std::atomic<std::uint64_t> m_sumNs;
+    std::atomic<std::uint64_t> m_maxNs;
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     */
+    LatencyHistogram();
+public: // Public interface.
+    /**
+     * @brief   Records a duration.
+     * @param   ns  The duration in nanoseconds.
+     * @remarks This routine is thread-safe and lock-free.
+     */
+    void record(std::uint64_t ns);
+
+    /**
+     * @brief   Copies the current state of the histogram.
+     * @return  The snapshot.
+     * @remarks This routine is thread-safe. Values recorded concurrently may or may not be part
+     *          of the snapshot, the counters are not guaranteed to be consistent with each other.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief   Gets the index of the bucket a value is counted in.
+     * @param   ns  The value.
+     * @return  The bucket index.
+     */
+    static unsigned bucketFor(std::uint64_t ns);
+
+    /**
+     * @brief   Gets the smallest value counted in a bucket.
+     * @param   index   The bucket index.
+     * @return  The lower bound in nanoseconds.
+     */
+    static std::uint64_t bucketLowerBound(unsigned index);
+
+    /**
+     * @brief   Gets the largest value counted in a bucket.
+     * @param   index   The bucket index.
+     * @return  The upper bound in nanoseconds.
+     */
+    static std::uint64_t bucketUpperBound(unsigned index);
+};
+
+// ============================================================================================== //
+// [SignalStatsSnapshot]                                                                          //
+// ============================================================================================== //
+
+/**
+ * @brief   Point-in-time statistics of a single slot.
+ * @ingroup sigstats
+ */
+struct SlotStatsSnapshot
+{
+    /**
+     * @brief   The slot handle assigned by the signal.
+     */
+    std::size_t handle;
+    /**
+     * @brief   The object the connection is bound to, @c nullptr for static slots.
+     */
+    const void* object;
+    /**
+     * @brief   The durations of all calls to the slot, direct, queued and asynchronous.
+     */
+    LatencyHistogram::Snapshot latency;
+};
+
+/**
+ * @brief   Point-in-time statistics of a signal.
+ * @ingroup sigstats
+ */
+struct SignalStatsSnapshot
+{
+    const void* signal;
+    std::string name;
+    std::uint64_t emits;
+    std::uint64_t connects;
+    std::uint64_t disconnects;
+    /**
+     * @brief   Disconnects caused by the destruction of the slot's object (included in
+     *          @c disconnects).
+     */
+    std::uint64_t objectDisconnects;
+    /**
+     * @brief   The currently connected slots, ordered by handle.
+     */
+    std::vector<SlotStatsSnapshot> slots;
+};
+
+// ============================================================================================== //
+// [SignalStats]                                                                                  //
+// ============================================================================================== //
+
+/**
+ * @brief   Instrumentation state of a single signal.
+ * @ingroup sigstats
+ *
+ * Registers itself with the @c SignalStatsRegistry for its whole lifetime. Counters are updated
+ * with relaxed atomics, the slot table is only locked on connect, disconnect and snapshot, never
+ * while emitting.
+ */
+class SignalStats : public NonCopyable
+{
+    friend class SignalStatsRegistry;
+public:
+    using SlotHistogramPtr = std::shared_ptr<LatencyHistogram>;
+private:
+    struct SlotEntry
+    {
+        const void* object;
+        SlotHistogramPtr latency;
+    };
+private:
+    const void* m_signal;
+    std::atomic<std::uint64_t> m_emits;
+    std::atomic<std::uint64_t> m_connects;
+    std::atomic<std::uint64_t> m_disconnects;
+    std::atomic<std::uint64_t> m_objectDisconnects;
+    mutable std::mutex m_mutex;
+    std::string m_name;
+    std::map<std::size_t, SlotEntry> m_slots;
+    // Links of the registry's list, guarded by the registry mutex.
+    SignalStats* m_prev;
+    SignalStats* m_next;
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor. Registers the statistics.
+     * @param   signal  The instrumented signal, used to identify it in snapshots.
+     */
+    explicit SignalStats(const void* signal);
+
+    /**
+     * @brief   Destructor. Unregisters the statistics.
+     */
+    ~SignalStats();
+public: // Public interface.
+    /**
+     * @brief   Sets the name the signal is reported with.
+     * @param   name    The name.
+     */
+    void setName(std::string name);
+
+    /**
+     * @brief   Gets the name the signal is reported with.
+     * @return  The name, empty if none was set.
+     */
+    std::string name() const;
+
+    /**
+     * @brief   Counts an emission.
+     */
+    void onEmit();
+
+    /**
+     * @brief   Registers a new slot.
+     * @param   handle  The slot handle.
+     * @param   object  The object the connection is bound to, @c nullptr for static slots.
+     * @return  The histogram the slot's call latencies are to be recorded in.
+     */
+    SlotHistogramPtr onConnect(std::size_t handle, const void* object);
+
+    /**
+     * @brief   Unregisters a slot.
+     * @param   handle          The slot handle.
+     * @param   objectDestroyed @c true if the slot's object is being destroyed.
+     */
+    void onDisconnect(std::size_t handle, bool objectDestroyed = false);
+
+    /**
+     * @brief   Copies the current statistics.
+     * @return  The snapshot.
+     * @remarks This routine is thread-safe.
+     */
+    SignalStatsSnapshot snapshot() const;
+};
+
+// ============================================================================================== //
+// [SignalStatsRegistry]                                                                          //
+// ============================================================================================== //
+
+/**
+ * @brief   Process-wide list of all live instrumented signals.
+ * @ingroup sigstats
+ */
+class SignalStatsRegistry : public NonCopyable
+{
+    friend class SignalStats;
+private:
+    std::mutex m_mutex;
+    SignalStats* m_head;
+    std::size_t m_numSignals;
+private:
+    SignalStatsRegistry();
+    static SignalStatsRegistry& instance();
+    void add(SignalStats* stats);
+    void remove(SignalStats* stats);
+public: // Public interface.
+    /**
+     * @brief   Gets the number of live instrumented signals.
+     * @return  The number of signals.
+     * @remarks This routine is thread-safe.
+     */
+    static std::size_t numSignals();
+
+    /**
+     * @brief   Copies the statistics of all live signals.
+     * @return  One snapshot per signal, most recently constructed signals first.
+     * @remarks This routine is thread-safe. Signals are kept from being destroyed while the
+     *          snapshot is taken, emissions are not blocked.
+     */
+    static std::vector<SignalStatsSnapshot> snapshot();
+};
+
+// ============================================================================================== //
+// [internal::ScopedSlotTimer]                                                                    //
+// ============================================================================================== //
+
+namespace internal
+{
+
+/**
+ * @brief   Records the lifetime of the timer into a slot's latency histogram.
+ */
+class ScopedSlotTimer : public NonCopyable
+{
+    using Clock = std::chrono::steady_clock;
+    LatencyHistogram* m_histogram;
+    Clock::time_point m_start;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   histogram   The histogram to record to. @c nullptr disables the timer.
+     */
+    explicit ScopedSlotTimer(LatencyHistogram* histogram);
+    ~ScopedSlotTimer();
+};
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [LatencyHistogram]                                            //
+// ============================================================================================== //
+
+inline std::uint64_t LatencyHistogram::Snapshot::meanNs() const
+{
+    return count ? sumNs / count : 0;
+}
+
+inline std::uint64_t LatencyHistogram::Snapshot::percentileNs(double percentile) const
+{
+    if (!count)
+    {
+        return 0;
+    }
+
+    auto rank = static_cast<std::uint64_t>(percentile / 100. * static_cast<double>(count));
+    if (rank < 1) rank = 1;
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            auto bound = bucketUpperBound(i);
+            return bound < maxNs ? bound : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+inline LatencyHistogram::LatencyHistogram()
+    : m_count(0)
+    , m_sumNs(0)
+    , m_maxNs(0)
+{
+    for (auto& curBucket : m_buckets)
+    {
+        curBucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+inline void LatencyHistogram::record(std::uint64_t ns)
+{
+    m_buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumNs.fetch_add(ns, std::memory_order_relaxed);
+
+    auto curMax = m_maxNs.load(std::memory_order_relaxed);
+    while (ns > curMax 
+        && !m_maxNs.compare_exchange_weak(curMax, ns, std::memory_order_relaxed));
+}
+
+inline LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot result;
+    result.buckets.resize(kNumBuckets);
+    for (unsigned i = 0; i < kNumBuckets; ++i)
+    {
+        result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        result.count += result.buckets[i];
+    }
+    result.sumNs = m_sumNs.load(std::memory_order_relaxed);
+    result.maxNs = m_maxNs.load(std::memory_order_relaxed);
+    return result;
+}
+
+inline unsigned LatencyHistogram::bucketFor(std::uint64_t ns)
+{
+    if (ns < kSubBuckets)
+    {
+        return static_cast<unsigned>(ns);
+    }
+    if (ns >> kMaxBits)
+    {
+        return kNumBuckets - 1;
+    }
+
+    unsigned msb;
+#if defined(ZYCORE_GNUC)
+    msb = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+#elif defined(ZYCORE_MSVC) && defined(ZYCORE_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, ns);
+    msb = static_cast<unsigned>(index);
+#else
+    msb = 0;
+    for (auto v = ns; v >>= 1;) ++msb;
+#endif
+
+    auto shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<unsigned>((ns >> shift) & (kSubBuckets - 1));
+}
+
+inline std::uint64_t LatencyHistogram::bucketLowerBound(unsigned index)
+{
+    if (index < kSubBuckets)
+    {
+        return index;
+    }
+
+    auto shift = index / kSubBuckets - 1;
+    return static_cast<std::uint64_t>(kSubBuckets + index % kSubBuckets) << shift;
+}
+
+inline std::uint64_t LatencyHistogram::bucketUpperBound(unsigned index)
+{
+    if (index < kSubBuckets)
+    {
+        return index;
+    }
+
+    auto shift = index / kSubBuckets - 1;
+    return bucketLowerBound(index) + (std::uint64_t(1) << shift) - 1;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [SignalStats]                                                 //
+// ============================================================================================== //
+
+inline SignalStats::SignalStats(const void* signal)
+    : m_signal(signal)
+    , m_emits(0)
+    , m_connects(0)
+    , m_disconnects(0)
+    , m_objectDisconnects(0)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+{
+    SignalStatsRegistry::instance().add(this);
+}
+
+inline SignalStats::~SignalStats()
+{
+    SignalStatsRegistry::instance().remove(this);
+}
+
+inline void SignalStats::setName(std::string name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_name = std::move(name);
+}
+
+inline std::string SignalStats::name() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_name;
+}
+
+inline void SignalStats::onEmit()
+{
+    m_emits.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline SignalStats::SlotHistogramPtr SignalStats::onConnect(std::size_t handle, 
+    const void* object)
+{
+    auto histogram = std::make_shared<LatencyHistogram>();
+    m_connects.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots[handle] = SlotEntry{object, histogram};
+    return histogram;
+}
+
+inline void SignalStats::onDisconnect(std::size_t handle, bool objectDestroyed)
+{
+    m_disconnects.fetch_add(1, std::memory_order_relaxed);
+    if (objectDestroyed)
+    {
+        m_objectDisconnects.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.erase(handle);
+}
+
+inline SignalStatsSnapshot SignalStats::snapshot() const
+{
+    SignalStatsSnapshot result;
+    result.signal = m_signal;
+    result.emits = m_emits.load(std::memory_order_relaxed);
+    result.connects = m_connects.load(std::memory_order_relaxed);
+    result.disconnects = m_disconnects.load(std::memory_order_relaxed);
+    result.objectDisconnects = m_objectDisconnects.load(std::memory_order_relaxed);
+
+    // Only the histogram pointers are copied under the lock, reading them may take a while.
+    std::vector<std::pair<std::size_t, SlotEntry>> slots;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        result.name = m_name;
+        slots.assign(m_slots.begin(), m_slots.end());
+    }
+
+    result.slots.reserve(slots.size());
+    for (const auto& curSlot : slots)
+    {
+        result.slots.push_back(SlotStatsSnapshot{
+            curSlot.first, curSlot.second.object, curSlot.second.latency->snapshot()});
+    }
+    return result;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [SignalStatsRegistry]                                         //
+// ============================================================================================== //
+
+inline SignalStatsRegistry::SignalStatsRegistry()
+    : m_head(nullptr)
+    , m_numSignals(0)
+{}
+
+inline SignalStatsRegistry& SignalStatsRegistry::instance()
+{
+    static SignalStatsRegistry registry;
+    return registry;
+}
+
+inline void SignalStatsRegistry::add(SignalStats* stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats->m_next = m_head;
+    if (m_head)
+    {
+        m_head->m_prev = stats;
+    }
+    m_head = stats;
+    ++m_numSignals;
+}
+
+inline void SignalStatsRegistry::remove(SignalStats* stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (stats->m_prev)
+    {
+        stats->m_prev->m_next = stats->m_next;
+    }
+    else
+    {
+        m_head = stats->m_next;
+    }
+    if (stats->m_next)
+    {
+        stats->m_next->m_prev = stats->m_prev;
+    }
+    --m_numSignals;
+}
+
+inline std::size_t SignalStatsRegistry::numSignals()
+{
+    auto& registry = instance();
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    return registry.m_numSignals;
+}
+
+inline std::vector<SignalStatsSnapshot> SignalStatsRegistry::snapshot()
+{
+    auto& registry = instance();
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    std::vector<SignalStatsSnapshot> result;
+    result.reserve(registry.m_numSignals);
+    for (auto cur = registry.m_head; cur; cur = cur->m_next)
+    {
+        result.push_back(cur->snapshot());
+    }
+    return result;
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::ScopedSlotTimer]                                   //
+// ============================================================================================== //
+
+namespace internal
+{
+
+inline ScopedSlotTimer::ScopedSlotTimer(LatencyHistogram* histogram)
+    : m_histogram(histogram)
+{
+    if (m_histogram)
+    {
+        m_start = Clock::now();
+    }
+}
+
+inline ScopedSlotTimer::~ScopedSlotTimer()
+{
+    if (m_histogram)
+    {
+        m_histogram->record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - m_start).count()));
+    }
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_SIGNALSTATS_HPP
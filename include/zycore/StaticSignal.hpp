@@ -0,0 +1,222 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ZYCORE_STATICSIGNAL_HPP
+#define ZYCORE_STATICSIGNAL_HPP
+
+#include "zycore/Signal.hpp"
+
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [StaticSlot]                                                                                   //
+// ============================================================================================== //
+
+namespace internal
+{
+    /**
+     * @brief   Object type of static slots not bound to an object.
+     */
+    struct NoObject {};
+} // namespace internal
+
+/**
+ * @brief   A function or member-function known at compile time, to be used with 
+ *          @c StaticSignal.
+ * @tparam  FuncT   The type of the function pointer or member-function pointer.
+ * @tparam  funcT   The function.
+ *                  
+ * Use @c ZYCORE_STATIC_SLOT to avoid spelling out the type.
+ */
+template<typename FuncT, FuncT funcT>
+struct StaticSlot;
+
+template<typename ResultT, typename... ParamsT, ResultT(*funcT)(ParamsT...)>
+struct StaticSlot<ResultT(*)(ParamsT...), funcT>
+{
+    using Object = internal::NoObject;
+
+    template<typename... CallArgsT>
+    static void call(Object* /*obj*/, CallArgsT&&... args)
+    {
+        funcT(std::forward<CallArgsT>(args)...);
+    }
+};
+
+template<typename ObjectT, typename ResultT, typename... ParamsT, 
+    ResultT(ObjectT::*funcT)(ParamsT...)>
+struct StaticSlot<ResultT(ObjectT::*)(ParamsT...), funcT>
+{
+    using Object = ObjectT;
+
+    template<typename... CallArgsT>
+    static void call(Object* obj, CallArgsT&&... args)
+    {
+        (obj->*funcT)(std::forward<CallArgsT>(args)...);
+    }
+};
+
+template<typename ObjectT, typename ResultT, typename... ParamsT, 
+    ResultT(ObjectT::*funcT)(ParamsT...) const>
+struct StaticSlot<ResultT(ObjectT::*)(ParamsT...) const, funcT>
+{
+    using Object = const ObjectT;
+
+    template<typename... CallArgsT>
+    static void call(Object* obj, CallArgsT&&... args)
+    {
+        (obj->*funcT)(std::forward<CallArgsT>(args)...);
+    }
+};
+
+/**
+ * @brief   Shorthand for a @c StaticSlot of the given function or member-function.
+ * @param   func    The function, e.g. @c &onInstruction or @c &Tracer::onInstruction.
+ */
+#define ZYCORE_STATIC_SLOT(func) ::zycore::StaticSlot<decltype(func), func>
+
+// ============================================================================================== //
+// [StaticSignal]                                                                                 //
+// ============================================================================================== //
+
+template<typename SignatureT, typename... SlotsT>
+class StaticSignal;
+
+/**
+ * @brief   Signal whose slots are fixed at compile time.
+ * @tparam  ArgsT   The slot's argument types.
+ * @tparam  SlotsT  The slots, see @c StaticSlot.
+ *
+ * Emitting calls the slots in order, directly and without any locking, indirection or
+ * bookkeeping, so the compiler is able to inline the whole dispatch. Arguments are passed just
+ * like with @c Signal::emit, which makes the two interchangeable at call sites:
+ * 
+ * @code
+ *     StaticSignal<void(const Instruction&), 
+ *         ZYCORE_STATIC_SLOT(&countInstruction), 
+ *         ZYCORE_STATIC_SLOT(&Tracer::onInstruction)> sigInstruction{nullptr, &tracer};
+ *     sigInstruction(instr);
+ * @endcode
+ * 
+ * The signal is not thread-safe in itself, slots being called concurrently have to be.
+ */
+template<typename... ArgsT, typename... SlotsT>
+class StaticSignal<void(ArgsT...), SlotsT...>
+{
+    std::tuple<typename SlotsT::Object*...> m_objects;
+public:
+    /**
+     * @brief   The number of slots.
+     */
+    static const std::size_t kNumSlots = sizeof...(SlotsT);
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor for signals not having member-function slots.
+     */
+    StaticSignal();
+
+    /**
+     * @brief   Constructor.
+     * @param   objects The objects to call the slots on, one for each slot in order. Slots that
+     *                  are free functions take a @c nullptr.
+     */
+    explicit StaticSignal(typename SlotsT::Object*... objects);
+public: // Public interface.
+    /**
+     * @brief   Gets the number of slots.
+     * @return  The number of slots.
+     */
+    constexpr std::size_t numSlots() const;
+
+    /**
+     * @brief   Emits the signal and calls all slots.
+     * @param   args  Arguments to be passed to the slots.
+     */
+    void emit(internal::SlotArg<ArgsT>... args) const;
+
+    /**
+     * @brief   Shorthand for @c emit.
+     */
+    void operator () (internal::SlotArg<ArgsT>... args) const;
+private:
+    template<std::size_t... idxT>
+    void emitImpl(std::index_sequence<idxT...>, internal::SlotArg<ArgsT>... args) const;
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [StaticSignal]                                                //
+// ============================================================================================== //
+
+template<typename... ArgsT, typename... SlotsT>
+inline StaticSignal<void(ArgsT...), SlotsT...>::StaticSignal()
+    : m_objects()
+{
+    static_assert(std::is_same<std::tuple<typename SlotsT::Object...>, 
+        std::tuple<std::conditional_t<true, internal::NoObject, SlotsT>...>>::value, 
+        "signals with member-function slots have to be constructed with objects");
+}
+
+template<typename... ArgsT, typename... SlotsT>
+inline StaticSignal<void(ArgsT...), SlotsT...>::StaticSignal(
+        typename SlotsT::Object*... objects)
+    : m_objects(objects...)
+{}
+
+template<typename... ArgsT, typename... SlotsT>
+inline constexpr std::size_t StaticSignal<void(ArgsT...), SlotsT...>::numSlots() const
+{
+    return kNumSlots;
+}
+
+template<typename... ArgsT, typename... SlotsT>
+inline void StaticSignal<void(ArgsT...), SlotsT...>::emit(internal::SlotArg<ArgsT>... args) const
+{
+    emitImpl(std::index_sequence_for<SlotsT...>(), args...);
+}
+
+template<typename... ArgsT, typename... SlotsT>
+inline void StaticSignal<void(ArgsT...), SlotsT...>::operator () (
+    internal::SlotArg<ArgsT>... args) const
+{
+    emitImpl(std::index_sequence_for<SlotsT...>(), args...);
+}
+
+template<typename... ArgsT, typename... SlotsT>
+template<std::size_t... idxT>
+inline void StaticSignal<void(ArgsT...), SlotsT...>::emitImpl(std::index_sequence<idxT...>, 
+    internal::SlotArg<ArgsT>... args) const
+{
+    // Braced initializers are evaluated left to right, so the slots are called in order.
+    using Expander = int[];
+    (void)Expander{0, (SlotsT::call(std::get<idxT>(m_objects), args...), 0)...};
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_STATICSIGNAL_HPP
@@ -0,0 +1,468 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_THREADPOOL_HPP
+#define ZYCORE_THREADPOOL_HPP
+
+#include "zycore/Utils.hpp"
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <algorithm>
+
+namespace zycore
+{
+
+class ThreadPool;
+class Completion;
+
+// ============================================================================================== //
+// [internal::CompletionState]                                                                    //
+// ============================================================================================== //
+
+namespace internal
+{
+
+/**
+ * @brief   Shared state of a group of tasks, see @c Completion.
+ *          
+ * Tasks only hold a raw pointer to the state, the state keeps itself alive until the last 
+ * task signals completion. This keeps task objects small enough for @c std::function's small 
+ * buffer, so submitting a task does not allocate.
+ */
+class CompletionState : public NonCopyable
+{
+    friend class zycore::Completion;
+
+    ThreadPool* m_pool;
+    std::atomic<std::size_t> m_pending;
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    std::shared_ptr<CompletionState> m_self;
+public:
+    /**
+     * @brief   Constructor.
+     * @param   pool        The pool the tasks are executed by.
+     * @param   numTasks    The number of tasks in the group. May NOT be 0.
+     */
+    CompletionState(ThreadPool* pool, std::size_t numTasks);
+
+    /**
+     * @brief   Destructor.
+     */
+    virtual ~CompletionState() = default;
+
+    /**
+     * @brief   Makes the state own itself until all tasks are done.
+     * @param   self    A shared pointer to this instance.
+     */
+    void keepAlive(std::shared_ptr<CompletionState> self);
+
+    /**
+     * @brief   Called by every task of the group when it is done.
+     * @remarks This routine is thread-safe. The instance may be deleted when it returns.
+     */
+    void taskDone();
+
+    /**
+     * @brief   Determines whether all tasks are done.
+     * @return  @c true if all tasks are done, else @c false.
+     */
+    bool isDone() const;
+};
+
+} // namespace internal
+
+// ============================================================================================== //
+// [Completion]                                                                                   //
+// ============================================================================================== //
+
+/**
+ * @brief   Lightweight handle to a group of tasks submitted to a @c ThreadPool.
+ *          
+ * Dropping the handle does not cancel or wait for the tasks.
+ */
+class Completion
+{
+    std::shared_ptr<internal::CompletionState> m_state;
+public:
+    /**
+     * @brief   Default constructor. Creates a handle that is already done.
+     */
+    Completion() = default;
+
+    /**
+     * @brief   Constructor.
+     * @param   state   The shared state of the task group.
+     */
+    explicit Completion(std::shared_ptr<internal::CompletionState> state);
+
+    /**
+     * @brief   Determines whether all tasks are done.
+     * @return  @c true if all tasks are done, else @c false.
+     * @remarks This routine is thread-safe.
+     */
+    bool isDone() const;
+
+    /**
+     * @brief   Blocks until all tasks are done.
+     *          
+     * When called from a worker of the executing pool, the calling thread runs pending tasks
+     * while waiting instead of blocking, so waiting from within a task can't deadlock the pool.
+     */
+    void wait() const;
+};
+
+// ============================================================================================== //
+// [ThreadPool]                                                                                   //
+// ============================================================================================== //
+
+/**
+ * @brief   Work-stealing thread pool.
+ *          
+ * Every worker owns a task deque. Workers pop tasks from the back of their own deque and, 
+ * when it runs dry, steal from the front of the other workers' deques. Tasks submitted from a
+ * worker go to that worker's deque, tasks submitted from other threads are spread round-robin.
+ */
+class ThreadPool : public NonCopyable
+{
+public:
+    using Task = std::function<void()>;
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        // Keeps neighbouring queues' locks off this queue's cache line without requiring
+        // over-aligned allocation support.
+        char padding[64];
+    };
+
+    struct WorkerContext
+    {
+        ThreadPool* pool;
+        std::size_t index;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_numQueued;
+    std::atomic<std::size_t> m_nextQueue;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_taskQueued;
+    bool m_stop;
+private:
+    static WorkerContext& workerContext();
+    bool tryPop(std::size_t index, Task& task);
+    void workerMain(std::size_t index);
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   numThreads  The number of worker threads. 0 selects the number of hardware 
+     *                      threads.
+     */
+    explicit ThreadPool(std::size_t numThreads = 0);
+
+    /**
+     * @brief   Destructor. Runs all queued tasks, then joins the workers.
+     */
+    ~ThreadPool();
+public: // Public interface.
+    /**
+     * @brief   Gets the process-wide default pool.
+     * @return  The default pool.
+     * @remarks This routine is thread-safe.
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief   Gets the number of worker threads.
+     * @return  The number of worker threads.
+     */
+    std::size_t numThreads() const;
+
+    /**
+     * @brief   Determines whether the calling thread is a worker of this pool.
+     * @return  @c true if called from a worker, else @c false.
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * @brief   Queues a task for execution.
+     * @param   task    The task.
+     * @remarks This routine is thread-safe.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief   Runs one queued task on the calling thread, if there is any.
+     * @return  @c true if a task was run, else @c false.
+     */
+    bool runPendingTask();
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [internal::CompletionState]                                   //
+// ============================================================================================== //
+
+namespace internal
+{
+
+inline CompletionState::CompletionState(ThreadPool* pool, std::size_t numTasks)
+    : m_pool(pool)
+    , m_pending(numTasks)
+{}
+
+inline void CompletionState::keepAlive(std::shared_ptr<CompletionState> self)
+{
+    m_self = std::move(self);
+}
+
+inline void CompletionState::taskDone()
+{
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    // Last one out: drop the self-reference only after waking up the waiters.
+    auto self = std::move(m_self);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_done.notify_all();
+}
+
+inline bool CompletionState::isDone() const
+{
+    return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+} // namespace internal
+
+// ============================================================================================== //
+// Implementation of inline methods [Completion]                                                  //
+// ============================================================================================== //
+
+inline Completion::Completion(std::shared_ptr<internal::CompletionState> state)
+    : m_state(std::move(state))
+{}
+
+inline bool Completion::isDone() const
+{
+    return !m_state || m_state->isDone();
+}
+
+inline void Completion::wait() const
+{
+    if (!m_state)
+    {
+        return;
+    }
+
+    if (m_state->m_pool->isWorkerThread())
+    {
+        while (!m_state->isDone())
+        {
+            if (!m_state->m_pool->runPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_state->m_mutex);
+    m_state->m_done.wait(lock, [this] { return m_state->isDone(); });
+}
+
+// ============================================================================================== //
+// Implementation of inline methods [ThreadPool]                                                  //
+// ============================================================================================== //
+
+inline ThreadPool::ThreadPool(std::size_t numThreads)
+    : m_numQueued(0)
+    , m_nextQueue(0)
+    , m_stop(false)
+{
+    if (!numThreads)
+    {
+        numThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    for (std::size_t i = 0; i < numThreads; ++i)
+    {
+        m_queues.emplace_back(new WorkerQueue);
+    }
+
+    for (std::size_t i = 0; i < numThreads; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::workerMain, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_taskQueued.notify_all();
+
+    for (auto& curThread : m_threads)
+    {
+        curThread.join();
+    }
+}
+
+inline ThreadPool::WorkerContext& ThreadPool::workerContext()
+{
+    static thread_local WorkerContext context{nullptr, 0};
+    return context;
+}
+
+inline ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline std::size_t ThreadPool::numThreads() const
+{
+    return m_threads.size();
+}
+
+inline bool ThreadPool::isWorkerThread() const
+{
+    return workerContext().pool == this;
+}
+
+inline void ThreadPool::submit(Task task)
+{
+    auto& context = workerContext();
+    auto index = context.pool == this 
+        ? context.index 
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    // Counted before the task becomes visible, so a worker popping it right away can't take the
+    // count below zero. Taking the sleep lock orders the increment before a worker's predicate
+    // check, so a worker about to fall asleep can't miss the notification.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_numQueued.fetch_add(1, std::memory_order_release);
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.emplace_back(std::move(task));
+    }
+    catch (...)
+    {
+        m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+    m_taskQueued.notify_one();
+}
+
+inline bool ThreadPool::tryPop(std::size_t index, Task& task)
+{
+    // Own queue first, LIFO for cache locality.
+    {
+        auto& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest task of some other worker.
+    for (std::size_t i = 1; i < m_queues.size(); ++i)
+    {
+        auto& victim = *m_queues[(index + i) % m_queues.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline bool ThreadPool::runPendingTask()
+{
+    auto& context = workerContext();
+    Task task;
+    if (!tryPop(context.pool == this ? context.index : 0, task))
+    {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+inline void ThreadPool::workerMain(std::size_t index)
+{
+    workerContext() = WorkerContext{this, index};
+
+    Task task;
+    for (;;)
+    {
+        if (tryPop(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_stop && !m_numQueued.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        m_taskQueued.wait(lock, [this]
+        {
+            return m_stop || m_numQueued.load(std::memory_order_acquire);
+        });
+    }
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_THREADPOOL_HPP
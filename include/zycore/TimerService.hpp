@@ -0,0 +1,630 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ZYCORE_TIMERSERVICE_HPP
+#define ZYCORE_TIMERSERVICE_HPP
+
+#include "zycore/SignalObject.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace zycore
+{
+
+/**
+ * @brief   Handle identifying a timer, @c 0 is never a valid handle.
+ */
+using TimerHandle = uint64_t;
+
+// ============================================================================================== //
+// [TimerService]                                                                                 //
+// ============================================================================================== //
+
+/**
+ * @brief   Timer scheduler based on a hierarchical timing wheel.
+ *          
+ * Time is divided into ticks of a fixed resolution. Timers due within the next 256 ticks are 
+ * kept in the slots of the first wheel, timers further away in the coarser slots of the upper 
+ * wheels, which are cascaded down as time advances. Scheduling and cancelling a timer takes 
+ * constant time, independent of the number of timers; timers are stored in a table reused 
+ * across timers, so plain timers don't allocate once the table has grown.
+ * 
+ * Expired timers are reported through @c sigExpired. Timers scheduled with a slot call that slot
+ * once, through a connection bound to a signal object: the call is queued to the object's event
+ * loop just like a signal emission, and dropped if the object is destroyed first.
+ * 
+ * Time advances when @c poll or @c advanceTo is called, or continuously in @c run. Timers fire 
+ * on the first tick at or after their deadline.
+ */
+class TimerService : public NonCopyable
+{
+    static const unsigned kWheelBits = 8;
+    static const unsigned kNumWheels = 4;
+    static const uint32_t kWheelSize = 1u << kWheelBits;
+    static const uint32_t kWheelMask = kWheelSize - 1;
+    static const uint32_t kNil = UINT32_MAX;
+
+    /**
+     * @brief   Entry of the timer table, either scheduled or part of the free list.
+     */
+    struct Timer
+    {
+        uint64_t expiry;
+        uint32_t generation;
+        uint32_t bucket;
+        uint32_t prev;
+        uint32_t next;
+        SlotHandle slot;
+    };
+
+    /**
+     * @brief   A timer that expired and is about to be reported.
+     */
+    struct Expiration
+    {
+        TimerHandle handle;
+        SlotHandle slot;
+    };
+public:
+    using Clock = std::chrono::steady_clock;
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    Clock::time_point m_origin;
+    Clock::duration m_resolution;
+    uint64_t m_now;
+    std::vector<Timer> m_timers;
+    uint32_t m_freeTimer;
+    std::size_t m_numTimers;
+    std::array<uint32_t, kNumWheels * kWheelSize> m_buckets;
+    std::array<std::size_t, kNumWheels> m_wheelCounts;
+    std::vector<Expiration> m_expired;
+    uint64_t m_wakeupTick;
+    bool m_quit;
+    Signal<> m_slots;
+public: // Con- & Destructor.
+    /**
+     * @brief   Constructor.
+     * @param   resolution  The tick length.
+     */
+    explicit TimerService(Clock::duration resolution = std::chrono::milliseconds(1));
+public: // Public interface.
+    /**
+     * @brief   Gets the tick length.
+     * @return  The resolution.
+     */
+    Clock::duration resolution() const;
+
+    /**
+     * @brief   Gets the number of scheduled timers.
+     * @return  The number of timers.
+     * @remarks This routine is thread-safe.
+     */
+    std::size_t numTimers() const;
+
+    /**
+     * @brief   Schedules a timer reported through @c sigExpired.
+     * @param   delay   The time until the timer expires.
+     * @return  The timer handle.
+     * @remarks This routine is thread-safe.
+     */
+    TimerHandle schedule(Clock::duration delay);
+
+    /**
+     * @brief   Schedules a timer calling a slot once.
+     * @param   delay           The time until the timer expires.
+     * @param   lifetimeObject  The object the slot is bound to, see @c Signal::connect. May be
+     *                          @c nullptr for slots that are always called directly.
+     * @param   func            The slot.
+     * @return  The timer handle.
+     * @remarks This routine is thread-safe.
+     */
+    template<typename FuncT>
+    TimerHandle schedule(Clock::duration delay, SignalObject* lifetimeObject, FuncT&& func);
+
+    /**
+     * @brief   Cancels a timer.
+     * @param   handle  The timer handle.
+     * @return  @c true on success, @c false if the timer already expired or didn't exist.
+     * @remarks This routine is thread-safe. A timer that expired in the very @c poll that is
+     *          running on another thread may still be reported.
+     */
+    bool cancel(TimerHandle handle);
+
+    /**
+     * @brief   Fires all timers due by now.
+     * @return  The number of timers fired.
+     */
+    std::size_t poll();
+
+    /**
+     * @brief   Fires all timers due by the given point in time.
+     * @param   now The point in time to advance the wheels to.
+     * @return  The number of timers fired.
+     *          
+     * The expirations are reported without holding the service's lock, so slots may schedule 
+     * and cancel timers.
+     */
+    std::size_t advanceTo(Clock::time_point now);
+
+    /**
+     * @brief   Fires timers as they expire until @c quit is called. Sleeps until the next tick
+     *          that may fire timers, or while no timers are scheduled.
+     */
+    void run();
+
+    /**
+     * @brief   Makes @c run return.
+     * @remarks This routine is thread-safe.
+     */
+    void quit();
+public: // Signals.
+    /**
+     * @brief   Signal emitted for every expired timer, with its handle.
+     */
+    Signal<TimerHandle> sigExpired;
+private:
+    /**
+     * @brief   Adds a timer to the table and the wheels.
+     * @remarks The lock has to be held.
+     */
+    TimerHandle add(Clock::duration delay, SlotHandle slot);
+
+    /**
+     * @brief   Looks up a scheduled timer by its handle.
+     * @return  The table index or @c kNil.
+     * @remarks The lock has to be held.
+     */
+    uint32_t find(TimerHandle handle) const;
+
+    /**
+     * @brief   Releases a timer's table entry, invalidating its handle.
+     * @remarks The lock has to be held.
+     */
+    void free(uint32_t index);
+
+    /**
+     * @brief   Puts a timer into the bucket matching its expiry.
+     * @remarks The lock has to be held.
+     */
+    void insert(uint32_t index);
+
+    /**
+     * @brief   Removes a timer from its bucket.
+     * @remarks The lock has to be held.
+     */
+    void unlinkTimer(uint32_t index);
+
+    /**
+     * @brief   Advances the wheels by a single tick, collecting the expired timers.
+     * @remarks The lock has to be held.
+     */
+    void tick();
+
+    /**
+     * @brief   Jumps over ticks that neither fire nor cascade timers, up to the tick before the 
+     *          next one that might.
+     * @param   target  The tick not to go beyond.
+     * @remarks The lock has to be held.
+     */
+    void skipIdleTicks(uint64_t target);
+
+    /**
+     * @brief   Gets the first tick after the current one that might fire or cascade timers.
+     * @remarks The lock has to be held.
+     */
+    uint64_t nextActiveTick() const;
+
+    /**
+     * @brief   Gets the tick a point in time falls into.
+     */
+    uint64_t tickAt(Clock::time_point time) const;
+
+    /**
+     * @brief   Gets the point in time a tick starts at, clamped to the range of the clock.
+     */
+    Clock::time_point timeAt(uint64_t tick) const;
+};
+
+// ============================================================================================== //
+// Implementation of inline methods [TimerService]                                                //
+// ============================================================================================== //
+
+inline TimerService::TimerService(Clock::duration resolution)
+    : m_origin(Clock::now())
+    , m_resolution(resolution)
+    , m_now(0)
+    , m_freeTimer(kNil)
+    , m_numTimers(0)
+    , m_wakeupTick(0)
+    , m_quit(false)
+{
+    for (auto& curBucket : m_buckets)
+    {
+        curBucket = kNil;
+    }
+    m_wheelCounts.fill(0);
+}
+
+inline TimerService::Clock::duration TimerService::resolution() const
+{
+    return m_resolution;
+}
+
+inline std::size_t TimerService::numTimers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numTimers;
+}
+
+inline TimerHandle TimerService::schedule(Clock::duration delay)
+{
+    return add(delay, 0);
+}
+
+template<typename FuncT>
+inline TimerHandle TimerService::schedule(Clock::duration delay, SignalObject* lifetimeObject, 
+    FuncT&& func)
+{
+    auto slot = lifetimeObject 
+        ? m_slots.connect(lifetimeObject, std::forward<FuncT>(func))
+        : m_slots.connect(std::forward<FuncT>(func));
+    return add(delay, slot);
+}
+
+inline bool TimerService::cancel(TimerHandle handle)
+{
+    SlotHandle slot;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto index = find(handle);
+        if (index == kNil)
+        {
+            return false;
+        }
+        slot = m_timers[index].slot;
+        unlinkTimer(index);
+        free(index);
+    }
+
+    if (slot)
+    {
+        m_slots.disconnect(slot);
+    }
+    return true;
+}
+
+inline std::size_t TimerService::poll()
+{
+    return advanceTo(Clock::now());
+}
+
+inline std::size_t TimerService::advanceTo(Clock::time_point now)
+{
+    std::vector<Expiration> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto target = tickAt(now);
+        while (m_now < target)
+        {
+            skipIdleTicks(target);
+            if (m_now < target)
+            {
+                tick();
+            }
+        }
+        expired.swap(m_expired);
+    }
+
+    for (const auto& curExpiration : expired)
+    {
+        sigExpired.emit(curExpiration.handle);
+        if (curExpiration.slot)
+        {
+            m_slots.emitTo(curExpiration.slot);
+            m_slots.disconnect(curExpiration.slot);
+        }
+    }
+
+    auto numExpired = expired.size();
+    expired.clear();
+    {
+        // Hand the buffer back, so steady polling doesn't allocate.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_expired.empty())
+        {
+            expired.swap(m_expired);
+        }
+    }
+    return numExpired;
+}
+
+inline void TimerService::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_quit)
+    {
+        // Timers scheduled ahead of the tick slept until wake the thread up, see @c add.
+        if (m_numTimers)
+        {
+            m_wakeupTick = nextActiveTick();
+            m_wakeup.wait_until(lock, timeAt(m_wakeupTick));
+        }
+        else
+        {
+            m_wakeupTick = UINT64_MAX;
+            m_wakeup.wait(lock, [this] { return m_numTimers || m_quit; });
+        }
+        m_wakeupTick = 0;
+
+        lock.unlock();
+        poll();
+        lock.lock();
+    }
+    m_quit = false;
+}
+
+inline void TimerService::quit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wakeup.notify_all();
+}
+
+inline TimerHandle TimerService::add(Clock::duration delay, SlotHandle slot)
+{
+    // Round up, timers never fire early.
+    auto ticks = (delay + m_resolution - Clock::duration(1)) / m_resolution;
+    auto expiry = tickAt(Clock::now()) + static_cast<uint64_t>(std::max<decltype(ticks)>(ticks, 1));
+
+    bool wakeup;
+    TimerHandle handle;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t index;
+        if (m_freeTimer != kNil)
+        {
+            index = m_freeTimer;
+            m_freeTimer = m_timers[index].next;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_timers.size());
+            m_timers.push_back(Timer{0, 1, kNil, kNil, kNil, 0});
+        }
+
+        // The wheels may have advanced past the tick the delay was based on in the meantime.
+        auto& timer = m_timers[index];
+        timer.expiry = std::max(expiry, m_now + 1);
+        timer.slot = slot;
+        insert(index);
+
+        ++m_numTimers;
+        wakeup = timer.expiry < m_wakeupTick;
+        handle = (TimerHandle(timer.generation) << 32) | index;
+    }
+
+    if (wakeup)
+    {
+        m_wakeup.notify_all();
+    }
+    return handle;
+}
+
+inline uint32_t TimerService::find(TimerHandle handle) const
+{
+    auto index = static_cast<uint32_t>(handle);
+    if (index >= m_timers.size() || m_timers[index].generation != handle >> 32 || 
+        m_timers[index].bucket == kNil)
+    {
+        return kNil;
+    }
+    return index;
+}
+
+inline void TimerService::free(uint32_t index)
+{
+    auto& timer = m_timers[index];
+    if (!++timer.generation) ++timer.generation;
+    timer.bucket = kNil;
+    timer.next = m_freeTimer;
+    m_freeTimer = index;
+    --m_numTimers;
+}
+
+inline void TimerService::insert(uint32_t index)
+{
+    auto& timer = m_timers[index];
+
+    // Timers cascaded down for the current tick go into the slot about to be processed.
+    auto expiry = std::max(timer.expiry, m_now);
+    auto delta = expiry - m_now;
+
+    uint32_t bucket = kNil;
+    for (unsigned wheel = 0; wheel < kNumWheels; ++wheel)
+    {
+        if (delta < (uint64_t(1) << (kWheelBits * (wheel + 1))))
+        {
+            bucket = wheel * kWheelSize + ((expiry >> (kWheelBits * wheel)) & kWheelMask);
+            break;
+        }
+    }
+    if (bucket == kNil)
+    {
+        // Beyond the range of the wheels, parked in the farthest slot and re-inserted from there.
+        const auto kTopShift = kWheelBits * (kNumWheels - 1);
+        auto farthest = m_now + (uint64_t(1) << (kWheelBits * kNumWheels)) - 1;
+        bucket = (kNumWheels - 1) * kWheelSize + ((farthest >> kTopShift) & kWheelMask);
+    }
+
+    ++m_wheelCounts[bucket / kWheelSize];
+    timer.bucket = bucket;
+    timer.prev = kNil;
+    timer.next = m_buckets[bucket];
+    if (timer.next != kNil)
+    {
+        m_timers[timer.next].prev = index;
+    }
+    m_buckets[bucket] = index;
+}
+
+inline void TimerService::unlinkTimer(uint32_t index)
+{
+    auto& timer = m_timers[index];
+    --m_wheelCounts[timer.bucket / kWheelSize];
+    (timer.prev != kNil ? m_timers[timer.prev].next : m_buckets[timer.bucket]) = timer.next;
+    if (timer.next != kNil)
+    {
+        m_timers[timer.next].prev = timer.prev;
+    }
+}
+
+inline void TimerService::tick()
+{
+    ++m_now;
+
+    // Whenever a wheel wraps around, the next slot of the wheel above is due to be spread over 
+    // the finer wheels.
+    for (unsigned wheel = 1; wheel < kNumWheels; ++wheel)
+    {
+        if ((m_now >> (kWheelBits * (wheel - 1))) & kWheelMask)
+        {
+            break;
+        }
+
+        auto bucket = wheel * kWheelSize + ((m_now >> (kWheelBits * wheel)) & kWheelMask);
+        auto index = m_buckets[bucket];
+        m_buckets[bucket] = kNil;
+        while (index != kNil)
+        {
+            auto next = m_timers[index].next;
+            --m_wheelCounts[wheel];
+            insert(index);
+            index = next;
+        }
+    }
+
+    auto bucket = static_cast<uint32_t>(m_now & kWheelMask);
+    auto index = m_buckets[bucket];
+    m_buckets[bucket] = kNil;
+    while (index != kNil)
+    {
+        auto& timer = m_timers[index];
+        auto next = timer.next;
+        --m_wheelCounts[0];
+        if (timer.expiry <= m_now)
+        {
+            m_expired.push_back(Expiration{(TimerHandle(timer.generation) << 32) | index, 
+                timer.slot});
+            free(index);
+        }
+        else
+        {
+            insert(index);
+        }
+        index = next;
+    }
+}
+
+inline void TimerService::skipIdleTicks(uint64_t target)
+{
+    // With the wheels below empty, nothing happens before the lowest populated wheel is due to
+    // cascade its next slot, at the next multiple of its slot length.
+    unsigned wheel = 0;
+    while (wheel < kNumWheels && !m_wheelCounts[wheel])
+    {
+        ++wheel;
+    }
+    if (!wheel)
+    {
+        return;
+    }
+    if (wheel == kNumWheels)
+    {
+        m_now = target;
+        return;
+    }
+
+    auto slotLength = uint64_t(1) << (kWheelBits * wheel);
+    auto lastIdle = m_now | (slotLength - 1);
+    m_now = std::max(m_now, std::min(lastIdle, target));
+}
+
+inline uint64_t TimerService::nextActiveTick() const
+{
+    // Upper wheels only hand timers down when they cascade, at the next multiple of the slot
+    // length of the lowest populated one.
+    auto next = UINT64_MAX;
+    for (unsigned wheel = 1; wheel < kNumWheels; ++wheel)
+    {
+        if (m_wheelCounts[wheel])
+        {
+            next = ((m_now >> (kWheelBits * wheel)) + 1) << (kWheelBits * wheel);
+            break;
+        }
+    }
+
+    if (m_wheelCounts[0])
+    {
+        for (uint64_t tick = m_now + 1; tick < next && tick <= m_now + kWheelSize; ++tick)
+        {
+            if (m_buckets[tick & kWheelMask] != kNil)
+            {
+                return tick;
+            }
+        }
+    }
+    return next;
+}
+
+inline uint64_t TimerService::tickAt(Clock::time_point time) const
+{
+    if (time <= m_origin)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>((time - m_origin) / m_resolution);
+}
+
+inline TimerService::Clock::time_point TimerService::timeAt(uint64_t tick) const
+{
+    auto maxTick = static_cast<uint64_t>((Clock::time_point::max() - m_origin) / m_resolution);
+    if (tick >= maxTick)
+    {
+        return Clock::time_point::max();
+    }
+    return m_origin + m_resolution * static_cast<Clock::rep>(tick);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
+
+#endif // ZYCORE_TIMERSERVICE_HPP
@@ -148,9 +148,9 @@ namespace internal
     struct IsAnyOfImpl
     {
         static const bool kValue = std::conditional_t<
-            std::is_same<ComperandT, OthersT::Top>::value,
+            std::is_same<ComperandT, typename OthersT::Top>::value,
             IsAnyOfImplTrue,
-            IsAnyOfImpl<ComperandT, OthersT::PopFront>
+            IsAnyOfImpl<ComperandT, typename OthersT::PopFront>
         >::kValue;
     };
 
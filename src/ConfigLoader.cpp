@@ -0,0 +1,657 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "zycore/ConfigLoader.hpp"
+#include "zycore/Exceptions.hpp"
+#include "zycore/ObjectRegistry.hpp"
+#include "zycore/Property.hpp"
+#include "zycore/ReflectableObject.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [ConfigParser]                                                                                 //
+// ============================================================================================== //
+
+namespace
+{
+
+/**
+ * @brief   A value to apply, referring to the configuration text.
+ */
+struct ConfigEntry
+{
+    ReflectableObject* object;
+    PropertyBase* property;
+    const char* first;
+    const char* last;
+    std::size_t line;
+};
+
+/**
+ * @brief   Single pass parser turning a configuration into resolved entries.
+ */
+class ConfigParser
+{
+    const char* m_cur;
+    const char* m_end;
+    std::size_t m_line;
+    const ConfigLoader::Resolver& m_resolver;
+    std::vector<ConfigEntry>& m_entries;
+    // Unescaped strings. Their characters stay in place as the deque grows.
+    std::deque<std::string>& m_strings;
+    NameRef m_lastObjectName;
+    ReflectableObject* m_lastObject;
+public:
+    ConfigParser(const char* first, const char* last, const ConfigLoader::Resolver& resolver,
+        std::vector<ConfigEntry>& entries, std::deque<std::string>& strings);
+public:
+    void parse();
+private:
+    [[noreturn]] void fail(const std::string& message) const;
+    static std::string quote(NameRef name);
+    static bool isBlank(char c);
+    static NameRef trim(const char* first, const char* last);
+    void skipSpace();
+    void skipLine();
+    NameRef parseString();
+    NameRef parseToken();
+    void add(NameRef key, NameRef value);
+    void add(NameRef objectName, NameRef propertyName, NameRef value);
+    void parseKeyValue();
+    void parseJson();
+    void parseJsonObject(const NameRef* objectName);
+};
+
+ConfigParser::ConfigParser(const char* first, const char* last,
+    const ConfigLoader::Resolver& resolver, std::vector<ConfigEntry>& entries,
+    std::deque<std::string>& strings)
+    : m_cur(first)
+    , m_end(last)
+    , m_line(1)
+    , m_resolver(resolver)
+    , m_entries(entries)
+    , m_strings(strings)
+    , m_lastObjectName(nullptr, 0)
+    , m_lastObject(nullptr)
+{
+
+}
+
+void ConfigParser::parse()
+{
+    skipSpace();
+    if (m_cur != m_end && *m_cur == '{')
+    {
+        parseJson();
+    }
+    else
+    {
+        parseKeyValue();
+    }
+}
+
+void ConfigParser::fail(const std::string& message) const
+{
+    throw InvalidUsage("line " + std::to_string(m_line) + ": " + message);
+}
+
+std::string ConfigParser::quote(NameRef name)
+{
+    return "'" + std::string(name.data(), name.size()) + "'";
+}
+
+bool ConfigParser::isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+NameRef ConfigParser::trim(const char* first, const char* last)
+{
+    while (first != last && isBlank(*first))
+    {
+        ++first;
+    }
+    while (last != first && isBlank(last[-1]))
+    {
+        --last;
+    }
+    return NameRef(first, static_cast<std::size_t>(last - first));
+}
+
+void ConfigParser::skipSpace()
+{
+    while (m_cur != m_end)
+    {
+        if (*m_cur == '\n')
+        {
+            ++m_line;
+        }
+        else if (*m_cur == '#')
+        {
+            skipLine();
+            continue;
+        }
+        else if (!isBlank(*m_cur))
+        {
+            return;
+        }
+        ++m_cur;
+    }
+}
+
+void ConfigParser::skipLine()
+{
+    m_cur = std::find(m_cur, m_end, '\n');
+}
+
+NameRef ConfigParser::parseString()
+{
+    assert(*m_cur == '"');
+    auto first = ++m_cur;
+    auto escaped = false;
+    for (;; ++m_cur)
+    {
+        if (m_cur == m_end)
+        {
+            fail("unterminated string");
+        }
+        if (*m_cur == '"')
+        {
+            break;
+        }
+        if (*m_cur == '\n')
+        {
+            ++m_line;
+        }
+        else if (*m_cur == '\\')
+        {
+            escaped = true;
+            if (++m_cur == m_end)
+            {
+                fail("unterminated string");
+            }
+        }
+    }
+    auto last = m_cur++;
+    if (!escaped)
+    {
+        return NameRef(first, static_cast<std::size_t>(last - first));
+    }
+
+    m_strings.emplace_back();
+    auto& result = m_strings.back();
+    result.reserve(static_cast<std::size_t>(last - first));
+    for (auto cur = first; cur != last; ++cur)
+    {
+        if (*cur != '\\')
+        {
+            result.push_back(*cur);
+            continue;
+        }
+        switch (*++cur)
+        {
+            case 'b': result.push_back('\b'); break;
+            case 'f': result.push_back('\f'); break;
+            case 'n': result.push_back('\n'); break;
+            case 'r': result.push_back('\r'); break;
+            case 't': result.push_back('\t'); break;
+            case 'u':
+            {
+                uint32_t codePoint = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (++cur == last || !std::isxdigit(static_cast<unsigned char>(*cur)))
+                    {
+                        fail("invalid unicode escape");
+                    }
+                    auto digit = static_cast<unsigned char>(*cur);
+                    codePoint = codePoint * 16 + (digit <= '9'
+                        ? digit - '0' : (digit | 0x20) - 'a' + 10);
+                }
+                if (codePoint >= 0xD800 && codePoint < 0xE000)
+                {
+                    fail("surrogate escapes are not supported");
+                }
+                if (codePoint < 0x80)
+                {
+                    result.push_back(static_cast<char>(codePoint));
+                }
+                else if (codePoint < 0x800)
+                {
+                    result.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                    result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                }
+                else
+                {
+                    result.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                    result.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                }
+                break;
+            }
+            default: result.push_back(*cur); break;
+        }
+    }
+    return NameRef(result);
+}
+
+NameRef ConfigParser::parseToken()
+{
+    if (*m_cur == '"')
+    {
+        return parseString();
+    }
+    auto first = m_cur;
+    while (m_cur != m_end && !isBlank(*m_cur) && !std::strchr("\n,:={}[]", *m_cur))
+    {
+        ++m_cur;
+    }
+    if (m_cur == first)
+    {
+        fail("unexpected " + (m_cur == m_end ? "end of input" : quote(NameRef(m_cur, 1))));
+    }
+    return NameRef(first, static_cast<std::size_t>(m_cur - first));
+}
+
+void ConfigParser::add(NameRef key, NameRef value)
+{
+    // Object names may contain dots themselves, property names don't.
+    auto last = key.data() + key.size();
+    auto dot = std::find(std::reverse_iterator<const char*>(last),
+        std::reverse_iterator<const char*>(key.data()), '.').base();
+    if (dot == key.data())
+    {
+        fail("expected objectName.propertyName, got " + quote(key));
+    }
+    add(NameRef(key.data(), static_cast<std::size_t>(dot - 1 - key.data())),
+        NameRef(dot, static_cast<std::size_t>(last - dot)), value);
+}
+
+void ConfigParser::add(NameRef objectName, NameRef propertyName, NameRef value)
+{
+    // Configurations usually list the properties of an object in a row.
+    if (!m_lastObject || objectName.size() != m_lastObjectName.size()
+        || std::memcmp(objectName.data(), m_lastObjectName.data(), objectName.size()) != 0)
+    {
+        m_lastObject = m_resolver(objectName);
+        if (!m_lastObject)
+        {
+            fail("unknown object " + quote(objectName));
+        }
+        m_lastObjectName = objectName;
+    }
+
+    auto property = m_lastObject->findProperty(propertyName);
+    if (!property)
+    {
+        fail("unknown property " + quote(propertyName) + " of object " + quote(objectName));
+    }
+    m_entries.push_back(ConfigEntry{
+        m_lastObject, property, value.data(), value.data() + value.size(), m_line});
+}
+
+void ConfigParser::parseKeyValue()
+{
+    NameRef section(nullptr, 0);
+    while (m_cur != m_end)
+    {
+        auto lineEnd = std::find(m_cur, m_end, '\n');
+        auto line = trim(m_cur, lineEnd);
+        m_cur = line.data() + line.size();
+        if (line.size() && line.data()[0] == '[')
+        {
+            if (line.data()[line.size() - 1] != ']')
+            {
+                fail("expected ']'");
+            }
+            section = trim(line.data() + 1, line.data() + line.size() - 1);
+            if (!section.size())
+            {
+                fail("empty section name");
+            }
+            m_cur = lineEnd;
+        }
+        else if (line.size() && line.data()[0] != '#' && line.data()[0] != ';')
+        {
+            auto assignment = std::find(line.data(), m_cur, '=');
+            if (assignment == m_cur)
+            {
+                fail("expected '='");
+            }
+            auto key = trim(line.data(), assignment);
+            if (!key.size())
+            {
+                fail("empty key");
+            }
+
+            m_cur = assignment + 1;
+            while (m_cur != lineEnd && isBlank(*m_cur))
+            {
+                ++m_cur;
+            }
+            NameRef value(nullptr, 0);
+            if (m_cur != lineEnd && *m_cur == '"')
+            {
+                value = parseString();
+                lineEnd = std::find(m_cur, m_end, '\n');
+                auto rest = trim(m_cur, lineEnd);
+                if (rest.size() && rest.data()[0] != '#' && rest.data()[0] != ';')
+                {
+                    fail("unexpected characters after string");
+                }
+            }
+            else
+            {
+                value = trim(m_cur, lineEnd);
+            }
+
+            if (section.size())
+            {
+                add(section, key, value);
+            }
+            else
+            {
+                add(key, value);
+            }
+            m_cur = lineEnd;
+        }
+        else
+        {
+            m_cur = lineEnd;
+        }
+
+        if (m_cur != m_end)
+        {
+            ++m_cur;
+            ++m_line;
+        }
+    }
+}
+
+void ConfigParser::parseJson()
+{
+    ++m_cur;
+    parseJsonObject(nullptr);
+    skipSpace();
+    if (m_cur != m_end)
+    {
+        fail("unexpected characters after configuration");
+    }
+}
+
+void ConfigParser::parseJsonObject(const NameRef* objectName)
+{
+    for (;;)
+    {
+        skipSpace();
+        if (m_cur == m_end)
+        {
+            fail("expected '}'");
+        }
+        if (*m_cur == '}')
+        {
+            ++m_cur;
+            return;
+        }
+
+        auto key = parseToken();
+        skipSpace();
+        if (m_cur == m_end || (*m_cur != ':' && *m_cur != '='))
+        {
+            fail("expected ':' after " + quote(key));
+        }
+        ++m_cur;
+        skipSpace();
+        if (m_cur == m_end)
+        {
+            fail("expected value for " + quote(key));
+        }
+
+        if (*m_cur == '{')
+        {
+            if (objectName)
+            {
+                fail("nested objects are only supported for object names");
+            }
+            ++m_cur;
+            parseJsonObject(&key);
+        }
+        else if (*m_cur == '[')
+        {
+            fail("arrays are not supported");
+        }
+        else
+        {
+            auto value = parseToken();
+            if (objectName)
+            {
+                add(*objectName, key, value);
+            }
+            else
+            {
+                add(key, value);
+            }
+        }
+
+        skipSpace();
+        if (m_cur != m_end && *m_cur == ',')
+        {
+            ++m_cur;
+        }
+        else if (m_cur == m_end || *m_cur != '}')
+        {
+            fail("expected ',' or '}'");
+        }
+    }
+}
+
+// ============================================================================================== //
+// [ConfigApplication]                                                                            //
+// ============================================================================================== //
+
+/**
+ * @brief   Applies the entries of a configuration, in parallel if worthwhile.
+ */
+class ConfigApplication : public internal::CompletionState
+{
+    std::vector<std::vector<const ConfigEntry*>> m_shards;
+    std::mutex m_errorLock;
+    std::size_t m_errorLine;
+    std::string m_error;
+    std::size_t m_numApplied;
+public:
+    ConfigApplication(ThreadPool* pool, std::size_t numShards);
+public:
+    static std::size_t apply(ThreadPool& pool, const std::vector<ConfigEntry>& entries);
+private:
+    void apply(const ConfigEntry* const* first, const ConfigEntry* const* last);
+    void run(std::size_t shard);
+    void throwIfFailed() const;
+};
+
+ConfigApplication::ConfigApplication(ThreadPool* pool, std::size_t numShards)
+    : CompletionState(pool, numShards)
+    , m_shards(numShards)
+    , m_errorLine(std::numeric_limits<std::size_t>::max())
+    , m_numApplied(0)
+{
+
+}
+
+std::size_t ConfigApplication::apply(ThreadPool& pool, const std::vector<ConfigEntry>& entries)
+{
+    // Below a few thousand entries handing them to other threads costs more than it saves.
+    const std::size_t kMinEntriesPerShard = 2048;
+    auto numShards = std::min(pool.numThreads() * 4, entries.size() / kMinEntriesPerShard);
+    if (numShards < 2 || pool.isWorkerThread())
+    {
+        ConfigApplication application(&pool, 0);
+        std::vector<const ConfigEntry*> all;
+        all.reserve(entries.size());
+        for (auto& entry : entries)
+        {
+            all.push_back(&entry);
+        }
+        application.apply(all.data(), all.data() + all.size());
+        application.throwIfFailed();
+        return application.m_numApplied;
+    }
+
+    // All values of an object go to the same shard, keeping their order.
+    auto application = std::make_shared<ConfigApplication>(&pool, numShards);
+    for (auto& shard : application->m_shards)
+    {
+        shard.reserve(entries.size() / numShards * 2);
+    }
+    for (auto& entry : entries)
+    {
+        auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(entry.object))
+            * 0x9E3779B97F4A7C15;
+        application->m_shards[static_cast<std::size_t>(hash >> 32) % numShards].push_back(&entry);
+    }
+    application->keepAlive(application);
+
+    auto rawApplication = application.get();
+    for (std::size_t i = 0; i < numShards; ++i)
+    {
+        pool.submit([rawApplication, i] { rawApplication->run(i); });
+    }
+    Completion(application).wait();
+    application->throwIfFailed();
+    return application->m_numApplied;
+}
+
+void ConfigApplication::apply(const ConfigEntry* const* first, const ConfigEntry* const* last)
+{
+    std::size_t numApplied = 0;
+    std::size_t errorLine = std::numeric_limits<std::size_t>::max();
+    std::string error;
+    for (; first != last; ++first)
+    {
+        auto& entry = **first;
+        try
+        {
+            if (!entry.property->supportsFromChars())
+            {
+                entry.property->fromString(std::string(entry.first, entry.last));
+            }
+            else if (!entry.property->tryFromChars(entry.first, entry.last))
+            {
+                throw InvalidUsage("invalid value provided");
+            }
+            ++numApplied;
+        }
+        catch (const std::exception& e)
+        {
+            if (entry.line < errorLine)
+            {
+                errorLine = entry.line;
+                error = "property '" + entry.property->name() + "': " + e.what();
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_errorLock);
+    m_numApplied += numApplied;
+    if (errorLine < m_errorLine)
+    {
+        m_errorLine = errorLine;
+        m_error = std::move(error);
+    }
+}
+
+void ConfigApplication::run(std::size_t shard)
+{
+    auto& entries = m_shards[shard];
+    apply(entries.data(), entries.data() + entries.size());
+    taskDone();
+}
+
+void ConfigApplication::throwIfFailed() const
+{
+    if (!m_error.empty())
+    {
+        throw InvalidUsage("line " + std::to_string(m_errorLine) + ": " + m_error);
+    }
+}
+
+} // namespace
+
+// ============================================================================================== //
+// [ConfigLoader]                                                                                 //
+// ============================================================================================== //
+
+ConfigLoader::ConfigLoader(ThreadPool& pool)
+    : m_pool(pool)
+    , m_resolver([](NameRef name) { return ObjectRegistry::instance().find(name); })
+{
+
+}
+
+std::size_t ConfigLoader::load(const char* first, const char* last)
+{
+    std::vector<ConfigEntry> entries;
+    std::deque<std::string> strings;
+    ConfigParser(first, last, m_resolver, entries, strings).parse();
+    return ConfigApplication::apply(m_pool, entries);
+}
+
+std::size_t ConfigLoader::loadFile(const std::string& path)
+{
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file)
+    {
+        throw OSException("fopen");
+    }
+
+    std::string text;
+    char buffer[64 * 1024];
+    std::size_t numRead;
+    while ((numRead = std::fread(buffer, 1, sizeof(buffer), file.get())) > 0)
+    {
+        text.append(buffer, numRead);
+    }
+    if (std::ferror(file.get()))
+    {
+        throw OSException("fread");
+    }
+    return load(text);
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
@@ -0,0 +1,115 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "zycore/MetaClass.hpp"
+#include "zycore/Exceptions.hpp"
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [MetaClass]                                                                                    //
+// ============================================================================================== //
+
+const MetaProperty& MetaClass::nextProperty(const MetaClass* parent, 
+    const MetaProperty* previous, const std::string& name, const std::string* typeName, 
+    std::ptrdiff_t offset)
+{
+    auto& link = previous ? previous->m_next : m_firstProperty;
+    auto next = link.load(std::memory_order_acquire);
+    if (!next)
+    {
+        std::lock_guard<std::mutex> lock(m_registrationLock);
+        next = link.load(std::memory_order_relaxed);
+        if (!next)
+        {
+            if (!previous)
+            {
+                m_parent = parent;
+                m_firstIndex = parent ? parent->numProperties() : 0;
+            }
+            auto numOwn = m_numOwnProperties.load(std::memory_order_relaxed);
+            m_storage.emplace_back(
+                new MetaProperty(this, name, typeName, offset, m_firstIndex + numOwn));
+            next = m_storage.back().get();
+            link.store(next, std::memory_order_release);
+            m_numOwnProperties.store(numOwn + 1, std::memory_order_release);
+        }
+    }
+
+    if (next->m_offset != offset || (!previous && m_parent != parent) || next->m_name != name)
+    {
+        throw InvalidUsage("properties have to be constructed identically for all instances");
+    }
+    return *next;
+}
+
+const internal::PropertyIndex& MetaClass::buildIndex() const
+{
+    std::lock_guard<std::mutex> lock(m_registrationLock);
+    auto numTotal = numProperties();
+    auto current = m_index.load(std::memory_order_relaxed);
+    if (current && current->numProperties == numTotal)
+    {
+        return *current;
+    }
+
+    std::unique_ptr<internal::PropertyIndex> index(new internal::PropertyIndex);
+    index->numProperties = numTotal;
+    index->properties.reserve(numTotal);
+    std::size_t numBuckets = 8;
+    while (numBuckets < numTotal * 2)
+    {
+        numBuckets *= 2;
+    }
+    index->buckets.resize(numBuckets, internal::PropertyIndex::Bucket{0, nullptr});
+
+    // Base class properties are inserted first, so equally named ones of derived classes
+    // replace them.
+    auto mask = numBuckets - 1;
+    forEachProperty([&](const MetaProperty& property)
+    {
+        index->properties.push_back(&property);
+        auto hash = NameRef(property.name()).hash();
+        for (auto i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask)
+        {
+            auto& bucket = index->buckets[i];
+            if (!bucket.property 
+                || (bucket.hash == hash && bucket.property->name() == property.name()))
+            {
+                bucket.hash = hash;
+                bucket.property = &property;
+                break;
+            }
+        }
+    });
+
+    // Readers may still use a previous, incomplete index, so it is kept alive.
+    m_indexStorage.emplace_back(std::move(index));
+    m_index.store(m_indexStorage.back().get(), std::memory_order_release);
+    return *m_indexStorage.back();
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
@@ -0,0 +1,239 @@
+/**
+ * This file is part of the zyan core library (zyantific.com).
+ * 
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015 Joel Höner (athre0z)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all copies or 
+ * substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, 
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "zycore/ObjectRegistry.hpp"
+#include "zycore/ReflectableObject.hpp"
+
+#include <thread>
+
+namespace zycore
+{
+
+// ============================================================================================== //
+// [ObjectRegistry]                                                                               //
+// ============================================================================================== //
+
+namespace
+{
+    /**
+     * @brief   Gets the reader shard of the calling thread.
+     * @return  The shard index, not yet reduced to the number of shards.
+     */
+    std::size_t threadShard()
+    {
+        static std::atomic<std::size_t> nextShard(0);
+        static thread_local std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+        return shard;
+    }
+} // namespace
+
+ObjectRegistry::ReadGuard::ReadGuard(const ObjectRegistry& registry)
+{
+    // Writers flip the epoch before waiting for its readers to finish. Checking the epoch again
+    // after announcing ourselves guarantees that they either wait for us or that we only see the
+    // chains they already unlinked their entries from.
+    auto shard = threadShard() % kNumShards;
+    for (;;)
+    {
+        auto epoch = registry.m_epoch.load();
+        m_count = &registry.m_readers[epoch & 1][shard].count;
+        m_count->fetch_add(1);
+        if (registry.m_epoch.load() == epoch)
+        {
+            break;
+        }
+        m_count->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+ObjectRegistry::ReadGuard::~ReadGuard()
+{
+    m_count->fetch_sub(1, std::memory_order_release);
+}
+
+ObjectRegistry::ObjectRegistry()
+    : m_enabled(false)
+    , m_table(createTable(64))
+    , m_numEntries(0)
+    , m_epoch(0)
+{
+    for (auto& epochReaders : m_readers)
+    {
+        for (auto& shard : epochReaders)
+        {
+            shard.count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ObjectRegistry::Table* ObjectRegistry::createTable(std::size_t numBuckets)
+{
+    auto table = new Table;
+    table->mask = numBuckets - 1;
+    table->byName.reset(new std::atomic<Entry*>[numBuckets]);
+    table->byType.reset(new std::atomic<Entry*>[numBuckets]);
+    for (std::size_t i = 0; i < numBuckets; ++i)
+    {
+        table->byName[i].store(nullptr, std::memory_order_relaxed);
+        table->byType[i].store(nullptr, std::memory_order_relaxed);
+    }
+    return table;
+}
+
+void ObjectRegistry::link(Table& table, Entry* entry)
+{
+    auto& nameHead = table.byName[static_cast<std::size_t>(entry->hash) & table.mask];
+    auto& typeHead = table.byType[static_cast<std::size_t>(hash(entry->metaClass)) & table.mask];
+    entry->nextByName.store(nameHead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    entry->nextByType.store(typeHead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    nameHead.store(entry, std::memory_order_release);
+    typeHead.store(entry, std::memory_order_release);
+}
+
+void ObjectRegistry::synchronize()
+{
+    auto epoch = m_epoch.load(std::memory_order_relaxed);
+    m_epoch.store(epoch + 1);
+    for (auto& shard : m_readers[epoch & 1])
+    {
+        while (shard.count.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ObjectRegistry::add(ReflectableObject& object)
+{
+    std::unique_ptr<Entry> entry(new Entry);
+    entry->name = object.objectName().value();
+    entry->hash = NameRef(entry->name).hash();
+    entry->object = &object;
+    entry->metaClass = object.metaClass();
+
+    std::lock_guard<std::mutex> lock(m_writeLock);
+    auto table = m_table.load(std::memory_order_relaxed);
+    if (m_numEntries > table->mask)
+    {
+        // Readers may be walking the chains of the current table, so the entries are copied
+        // rather than relinked, and the old ones only freed once no reader can see them.
+        std::unique_ptr<Table> oldTable(table);
+        table = createTable((table->mask + 1) * 2);
+        std::vector<std::unique_ptr<Entry>> oldEntries;
+        for (std::size_t i = 0; i <= oldTable->mask; ++i)
+        {
+            for (auto cur = oldTable->byName[i].load(std::memory_order_relaxed); cur; 
+                cur = cur->nextByName.load(std::memory_order_relaxed))
+            {
+                oldEntries.emplace_back(cur);
+            }
+        }
+        // Chains are rebuilt in reverse, so objects named last stay in front.
+        for (auto it = oldEntries.rbegin(); it != oldEntries.rend(); ++it)
+        {
+            auto copy = new Entry;
+            copy->name = (*it)->name;
+            copy->hash = (*it)->hash;
+            copy->object = (*it)->object;
+            copy->metaClass = (*it)->metaClass;
+            link(*table, copy);
+        }
+        m_table.store(table, std::memory_order_release);
+        synchronize();
+    }
+    link(*table, entry.release());
+    ++m_numEntries;
+}
+
+void ObjectRegistry::remove(ReflectableObject& object)
+{
+    auto name = NameRef(object.objectName().value());
+    auto nameHash = name.hash();
+
+    std::lock_guard<std::mutex> lock(m_writeLock);
+    auto table = m_table.load(std::memory_order_relaxed);
+    auto slot = &table->byName[static_cast<std::size_t>(nameHash) & table->mask];
+    Entry* entry;
+    for (;;)
+    {
+        entry = slot->load(std::memory_order_relaxed);
+        if (!entry)
+        {
+            return;
+        }
+        if (entry->object == &object)
+        {
+            break;
+        }
+        slot = &entry->nextByName;
+    }
+    slot->store(entry->nextByName.load(std::memory_order_relaxed), std::memory_order_release);
+
+    slot = &table->byType[static_cast<std::size_t>(hash(entry->metaClass)) & table->mask];
+    while (slot->load(std::memory_order_relaxed) != entry)
+    {
+        slot = &slot->load(std::memory_order_relaxed)->nextByType;
+    }
+    slot->store(entry->nextByType.load(std::memory_order_relaxed), std::memory_order_release);
+    --m_numEntries;
+
+    // Readers walking the chains may still be looking at the entry.
+    synchronize();
+    delete entry;
+}
+
+ReflectableObject* ObjectRegistry::find(NameRef name) const
+{
+    auto nameHash = name.hash();
+    ReadGuard guard(*this);
+    auto table = m_table.load(std::memory_order_acquire);
+    for (auto cur = table->byName[static_cast<std::size_t>(nameHash) & table->mask].load(
+        std::memory_order_acquire); cur; cur = cur->nextByName.load(std::memory_order_acquire))
+    {
+        if (cur->hash == nameHash && name == cur->name)
+        {
+            return cur->object;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<ReflectableObject*> ObjectRegistry::objectsOf(const MetaClass& metaClass) const
+{
+    std::vector<ReflectableObject*> objects;
+    ReadGuard guard(*this);
+    auto table = m_table.load(std::memory_order_acquire);
+    for (auto cur = table->byType[static_cast<std::size_t>(hash(&metaClass)) & table->mask].load(
+        std::memory_order_acquire); cur; cur = cur->nextByType.load(std::memory_order_acquire))
+    {
+        if (cur->metaClass == &metaClass)
+        {
+            objects.push_back(cur->object);
+        }
+    }
+    return objects;
+}
+
+// ============================================================================================== //
+
+} // namespace zycore
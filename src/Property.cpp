@@ -33,19 +33,6 @@ namespace zycore
 // [PropertyBase]                                                                                 //
 // ============================================================================================== //
 
-PropertyBase::PropertyBase(ReflectableObject* owner, const std::string& name)
-    : m_name(name)
-    , m_owner(owner)
-{
-    assert(owner);
-    owner->registerProperty(this);
-}
-
-PropertyBase::~PropertyBase()
-{
-    m_owner->unregisterProperty(this);
-}
-
 void PropertyBase::fromString(const std::string& /*val*/)
 {
     throw NotImplemented("writing string access is not implemented "
@@ -59,9 +46,48 @@ std::string PropertyBase::toString() const
     return ss.str();
 }
 
-const std::string& PropertyBase::name() const
+bool PropertyBase::tryFromChars(const char* /*first*/, const char* /*last*/)
+{
+    return false;
+}
+
+bool PropertyBase::supportsFromChars() const
+{
+    return false;
+}
+
+char* PropertyBase::toChars(char* first, char* last) const
+{
+    auto str = toString();
+    if (static_cast<std::size_t>(last - first) < str.size())
+    {
+        return nullptr;
+    }
+    return std::copy(str.cbegin(), str.cend(), first);
+}
+
+void PropertyBase::writeValue(OBinaryStream& stream) const
+{
+    auto str = toString();
+    auto len = static_cast<uint32_t>(str.size());
+    stream.rawWrite(stream.wpos(), sizeof(len), reinterpret_cast<const uint8_t*>(&len));
+    stream.rawWrite(stream.wpos() + sizeof(len), len, 
+        reinterpret_cast<const uint8_t*>(str.data()));
+    stream.wpos(stream.wpos() + sizeof(len) + len);
+}
+
+void PropertyBase::readValue(IBinaryStream& stream)
 {
-    return m_name;
+    uint32_t len;
+    stream.rawRead(stream.rpos(), sizeof(len), reinterpret_cast<uint8_t*>(&len));
+    if (len > stream.size() - stream.rpos() - sizeof(len))
+    {
+        throw OutOfBounds("value exceeds the stream");
+    }
+    std::string str(len, '\0');
+    stream.rawRead(stream.rpos() + sizeof(len), len, reinterpret_cast<uint8_t*>(&str[0]));
+    stream.rpos(stream.rpos() + sizeof(len) + len);
+    fromString(str);
 }
 
 // ============================================================================================== //
@@ -22,9 +22,11 @@
  */
 
 #include "zycore/ReflectableObject.hpp"
+#include "zycore/BinaryStream.hpp"
 #include "zycore/Exceptions.hpp"
+#include "zycore/ObjectRegistry.hpp"
+#include "zycore/Property.hpp"
 
-#include <algorithm>
 #include <string>
 
 namespace zycore
@@ -34,8 +36,23 @@ namespace zycore
 // [ReflectableObject]                                                                            //
 // ============================================================================================== //
 
+ReflectableObject::~ReflectableObject()
+{
+    if (m_isRegistered)
+    {
+        ObjectRegistry::instance().remove(*this);
+    }
+}
+
 void ReflectableObject::setObjectName(const std::string& name)
 {
+    auto& registry = ObjectRegistry::instance();
+    if (m_isRegistered)
+    {
+        registry.remove(*this);
+        m_isRegistered = false;
+    }
+
     if (!m_objectName)
     {
         m_objectName.reset(new std::string(name));
@@ -44,6 +61,12 @@ void ReflectableObject::setObjectName(const std::string& name)
     {
         *m_objectName = name;
     }
+
+    if (registry.isEnabled())
+    {
+        registry.add(*this);
+        m_isRegistered = true;
+    }
 }
 
 Optional<const std::string&> ReflectableObject::objectName() const
@@ -52,20 +75,119 @@ Optional<const std::string&> ReflectableObject::objectName() const
     return kEmpty;
 }
 
-void ReflectableObject::registerProperty(PropertyBase* prop)
+const MetaProperty& ReflectableObject::attachProperty(MetaClass& metaClass, 
+    const std::string& name, const std::string* typeName, std::ptrdiff_t offset)
+{
+    // Properties of a class are constructed in a row, after the ones of its base classes. The
+    // first property of a class continues the property list of the nearest base declaring any.
+    auto& property = m_metaClass == &metaClass 
+        ? metaClass.nextProperty(nullptr, m_lastProperty, name, typeName, offset)
+        : metaClass.nextProperty(m_metaClass, nullptr, name, typeName, offset);
+    m_metaClass = &metaClass;
+    m_lastProperty = &property;
+
+    // Each 64 properties beyond the first 64 need another word for their dirty bits.
+    auto index = property.index();
+    if (index >= 64 && index % 64 == 0)
+    {
+        auto numWords = index / 64;
+        std::unique_ptr<std::atomic<uint64_t>[]> moreDirty(new std::atomic<uint64_t>[numWords]);
+        for (std::size_t i = 0; i < numWords; ++i)
+        {
+            moreDirty[i] = i + 1 < numWords ? m_moreDirty[i].load() : 0;
+        }
+        m_moreDirty = std::move(moreDirty);
+    }
+    return property;
+}
+
+bool ReflectableObject::isDirty() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_propertyListLock);
-    if (std::find(m_propertyList.cbegin(), m_propertyList.cend(), prop) != m_propertyList.cend())
+    auto numProps = numProperties();
+    for (std::size_t i = 0; i < numProps; i += 64)
     {
-        throw InvalidUsage("property already registered");
+        if (dirtyWord(i).load(std::memory_order_acquire))
+        {
+            return true;
+        }
     }
-    m_propertyList.push_back(prop);
+    return false;
 }
 
-void ReflectableObject::unregisterProperty(PropertyBase* prop)
+void ReflectableObject::clearDirty()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_propertyListLock);
-    m_propertyList.erase(std::remove(m_propertyList.begin(), m_propertyList.end(), prop));
+    auto numProps = numProperties();
+    for (std::size_t i = 0; i < numProps; i += 64)
+    {
+        dirtyWord(i).store(0, std::memory_order_relaxed);
+    }
+}
+
+static void writePropertyEntry(OBinaryStream& stream, const PropertyBase* property)
+{
+    auto index = static_cast<uint32_t>(property->metaProperty().index());
+    stream.rawWrite(stream.wpos(), sizeof(index), reinterpret_cast<const uint8_t*>(&index));
+    stream.wpos(stream.wpos() + sizeof(index));
+    property->writeValue(stream);
+}
+
+std::size_t ReflectableObject::writeDelta(OBinaryStream& stream)
+{
+    // Deltas start with the number of entries, patched in at the end.
+    auto countPos = stream.wpos();
+    uint32_t count = 0;
+    stream.wpos(countPos + sizeof(count));
+
+    auto numProps = numProperties();
+    for (std::size_t i = 0; i < numProps; i += 64)
+    {
+        // Clearing before reading the values makes changes racing with this either part of
+        // the delta or leaves them dirty for the next one.
+        auto bits = dirtyWord(i).exchange(0, std::memory_order_acq_rel);
+        for (std::size_t bit = 0; bits; ++bit, bits >>= 1)
+        {
+            if (bits & 1)
+            {
+                writePropertyEntry(stream, m_metaClass->propertyAt(i + bit)->property(this));
+                ++count;
+            }
+        }
+    }
+
+    stream.rawWrite(countPos, sizeof(count), reinterpret_cast<const uint8_t*>(&count));
+    return count;
+}
+
+std::size_t ReflectableObject::writeSnapshot(OBinaryStream& stream) const
+{
+    auto count = static_cast<uint32_t>(numProperties());
+    stream.rawWrite(stream.wpos(), sizeof(count), reinterpret_cast<const uint8_t*>(&count));
+    stream.wpos(stream.wpos() + sizeof(count));
+    for (auto curProperty : properties())
+    {
+        writePropertyEntry(stream, curProperty);
+    }
+    return count;
+}
+
+std::size_t ReflectableObject::applyDelta(IBinaryStream& stream)
+{
+    uint32_t count;
+    stream.rawRead(stream.rpos(), sizeof(count), reinterpret_cast<uint8_t*>(&count));
+    stream.rpos(stream.rpos() + sizeof(count));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t index;
+        stream.rawRead(stream.rpos(), sizeof(index), reinterpret_cast<uint8_t*>(&index));
+        stream.rpos(stream.rpos() + sizeof(index));
+        auto property = m_metaClass ? m_metaClass->propertyAt(index) : nullptr;
+        if (!property)
+        {
+            throw OutOfBounds("delta refers to an unknown property");
+        }
+        property->property(this)->readValue(stream);
+    }
+    return count;
 }
 
 // ============================================================================================== //
@@ -23,8 +23,6 @@
 
 #include "zycore/SignalObject.hpp"
 
-#include <algorithm>
-
 namespace zycore
 {
 
@@ -32,35 +30,29 @@ namespace zycore
 // [SignalObject]                                                                                 //
 // ============================================================================================== //
 
+SignalObject::SignalObject()
+    : m_affinity(EventLoop::current())
+{}
+
 SignalObject::~SignalObject()
 {
     destroy();
 }
 
-void SignalObject::destroy()
+EventLoop* SignalObject::eventLoop() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_objectMutex);
-    sigDestroy();
-    for (const auto& curSignal: m_connectedSignals)
-    {
-        std::get<1>(curSignal)->onSlotsObjectDestroyed(std::get<0>(curSignal));
-    }
+    return m_affinity.loop();
 }
 
-void SignalObject::onSignalConnected(internal::SignalBase *signal, SlotHandle handle)
+void SignalObject::setEventLoop(EventLoop* loop)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_objectMutex);
-    m_connectedSignals.emplace_back(handle, signal);
+    m_affinity.setLoop(loop);
 }
 
-void SignalObject::onSignalDisconnected(internal::SignalBase *signal, SlotHandle handle)
+void SignalObject::destroy()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_objectMutex);
-    m_connectedSignals.erase(std::remove_if(m_connectedSignals.begin(), m_connectedSignals.end(),
-        [&](const decltype(*m_connectedSignals.data())& element) -> bool
-    {
-        return std::get<0>(element) == handle && std::get<1>(element) == signal;
-    }));
+    sigDestroy();
+    disconnectAll();
 }
 
 // ============================================================================================== //